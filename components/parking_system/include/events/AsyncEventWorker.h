@@ -0,0 +1,152 @@
+#pragma once
+
+#include "Event.h"
+#include "EventDispatchTable.h"
+#include "PackedEvent.h"
+#include "freertos/FreeRTOS.h"
+#include "freertos/queue.h"
+#include "freertos/semphr.h"
+#include "freertos/task.h"
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+/**
+ * @brief Settings of an async subscriber worker task
+ */
+struct AsyncWorkerConfig {
+    const char* name = "EventWorker"; // Task name (string literal)
+    size_t queueSize = 16;            // Events buffered for the worker
+    uint32_t stackSize = 4096;
+    UBaseType_t priority = 2;         // Keep below the event loop (5) so observers never delay the gates
+    BaseType_t core = tskNO_AFFINITY; // Core affinity, tskNO_AFFINITY for any core
+};
+
+/**
+ * @brief Counters of one async worker
+ */
+struct AsyncWorkerStats {
+    const char* name = nullptr;
+    size_t capacity = 0;
+    uint32_t delivered = 0;     // Events dispatched to the worker's handlers
+    uint32_t dropped = 0;       // Events lost because the worker queue was full
+    uint32_t queued = 0;        // Currently waiting in the worker queue
+    uint32_t highWatermark = 0; // Peak of queued
+};
+
+/**
+ * @brief Worker task that runs slow subscribers off the event loop
+ *
+ * Async subscribers (SubscribeOptions::async) are registered in the worker's
+ * own dispatch table. The event bus subscribes one forwarding handler per
+ * event type, which copies the event into the worker's bounded queue without
+ * blocking, but only if one of the worker's handlers matches its lane and
+ * payload filter; when the queue is full the event is dropped for this worker only
+ * and counted. Persistence, telemetry or display handlers can therefore be as
+ * slow as they like without adding latency to the gate state machines.
+ *
+ * Created and owned by FreeRtosEventBus (see createAsyncWorker()); the task
+ * runs while the bus event loop runs. Subscriptions copy the dispatch table
+ * and swap it in (copy-on-write), so dispatch picks up the table without
+ * taking a lock; replaced tables are freed once no dispatch still uses them.
+ */
+class AsyncEventWorker {
+  public:
+    explicit AsyncEventWorker(const AsyncWorkerConfig& config);
+    ~AsyncEventWorker();
+
+    // Prevent copying
+    AsyncEventWorker(const AsyncEventWorker&) = delete;
+    AsyncEventWorker& operator=(const AsyncEventWorker&) = delete;
+
+    /**
+     * @brief Add a handler to the worker's dispatch table
+     * @param profile Optional run time counters (must outlive the worker)
+     * @param filter Payload filter, evaluated on the worker
+     * @param source Lane to receive events from, EVENT_SOURCE_ANY for all
+     * @return true if this is the first handler for the type (bus must forward it)
+     */
+    bool subscribe(EventType type, EventHandler handler, HandlerProfile* profile, PayloadFilter filter = {},
+                   uint8_t source = EVENT_SOURCE_ANY);
+
+    /**
+     * @brief Add a category handler to the worker's dispatch table
+     * @return Bit per event type that needs a new forwarding handler on the bus
+     */
+    uint32_t subscribeCategory(EventCategoryMask categories, EventHandler handler, HandlerProfile* profile,
+                               uint8_t source = EVENT_SOURCE_ANY);
+
+    /**
+     * @brief Check if any of the worker's handlers (filter and lane included) wants the event
+     */
+    [[nodiscard]] bool accepts(const Event& event) const;
+
+    /**
+     * @brief Queue an event for the worker without blocking
+     * @return false if the worker queue is full (event counted as dropped)
+     */
+    bool post(const Event& event);
+
+    /**
+     * @brief Dispatch all queued events in the calling task (for synchronous testing)
+     * @return Number of events dispatched
+     */
+    size_t processPending();
+
+    /**
+     * @brief Start the worker task
+     */
+    void start();
+
+    /**
+     * @brief Stop the worker task and wait for it to exit
+     *
+     * Events still queued stay queued until the next start() or processPending().
+     */
+    void stop();
+
+    /**
+     * @brief Check if the worker task is running
+     */
+    [[nodiscard]] bool isRunning() const;
+
+    /**
+     * @brief Get a snapshot of the worker counters
+     */
+    [[nodiscard]] AsyncWorkerStats getStats() const;
+
+    /**
+     * @brief Reset delivered/dropped counters and the high-watermark
+     */
+    void resetStats();
+
+  private:
+    static void workerTask(void* pvParameters);
+    void dispatch(const PackedEvent& packed, std::atomic<uint32_t>& readers);
+    EventDispatchTable* beginTableUpdate();
+    void commitTableUpdate(EventDispatchTable* table);
+
+    /**
+     * @brief Marker type of the event that wakes the task for stop()
+     */
+    static constexpr uint8_t STOP_TOKEN = 0xFF;
+
+    AsyncWorkerConfig m_config;
+    QueueHandle_t m_queue = nullptr;
+    SemaphoreHandle_t m_mutex = nullptr;  // Guards table updates (subscribers)
+    SemaphoreHandle_t m_exited = nullptr; // Given by the task right before it deletes itself
+    TaskHandle_t m_task = nullptr;
+    std::atomic<EventDispatchTable*> m_table{nullptr};
+    mutable std::atomic<uint32_t> m_tableReaders{0};           // processPending()/accepts() using a table
+    std::atomic<uint32_t> m_taskReaders{0};                    // Worker task dispatch using a table
+    std::vector<std::unique_ptr<EventDispatchTable>> m_tables; // Active table is last
+    uint32_t m_forwardedMask = 0; // Event types the bus already forwards
+    std::atomic<uint32_t> m_delivered{0};
+    std::atomic<uint32_t> m_dropped{0};
+    std::atomic<uint32_t> m_queued{0};
+    std::atomic<uint32_t> m_highWatermark{0};
+};
+
+static_assert(EVENT_TYPE_COUNT <= 32, "AsyncEventWorker forwarded mask holds 32 event types");
@@ -1,43 +1,295 @@
 #pragma once
 
+#include "EventRegistry.h"
+#include "PayloadPool.h"
+#include <array>
+#include <cstddef>
 #include <cstdint>
+#include <string_view>
+#include <type_traits>
+#include <utility>
 #include <variant>
 
 /**
- * @brief Event types in the parking system
+ * @brief Event types in the parking system (generated from PARKING_EVENT_TYPES)
  */
 enum class EventType {
-    // Hardware Events (from GPIO interrupts)
-    EntryButtonPressed,
-    EntryButtonReleased,
-    EntryLightBarrierBlocked,
-    EntryLightBarrierCleared,
-    ExitLightBarrierBlocked,
-    ExitLightBarrierCleared,
-
-    // System Events
-    CapacityAvailable,
-    CapacityFull,
-    TicketIssued,
-    TicketValidated,
-    TicketRejected,
-
-    // State Events (for logging/monitoring)
-    EntryBarrierOpened,
-    EntryBarrierClosed,
-    ExitBarrierOpened,
-    ExitBarrierClosed,
-    CarEnteredParking,
-    CarExitedParking,
-
-    // Timer Events
-    BarrierTimeout
+#define PARKING_EVENT_ENUM(name, category, priority, payload, level) name,
+    PARKING_EVENT_TYPES(PARKING_EVENT_ENUM)
+#undef PARKING_EVENT_ENUM
 };
 
+/**
+ * @brief Number of event types (size of per-type lookup tables)
+ */
+inline constexpr size_t EVENT_TYPE_COUNT = 0
+#define PARKING_EVENT_COUNT(name, category, priority, payload, level) +1
+    PARKING_EVENT_TYPES(PARKING_EVENT_COUNT)
+#undef PARKING_EVENT_COUNT
+    ;
+
+/**
+ * @brief Get dense table index of an event type
+ */
+constexpr size_t eventTypeIndex(EventType type) {
+    return static_cast<size_t>(type);
+}
+
+/**
+ * @brief Event type as a compile-time constant
+ *
+ * Selects the handle() overload of a StaticEventBus subscriber, so the
+ * handler for a type is resolved during compilation.
+ */
+template <EventType T>
+using EventTag = std::integral_constant<EventType, T>;
+
+/**
+ * @brief Event bus delivery lanes
+ *
+ * High lane events are served first and have their own queue capacity, so a
+ * burst of monitoring events can never push out the sensor events the gate
+ * state machines depend on.
+ */
+enum class EventPriority {
+    High, // Sensor and control events (hardware inputs, timeouts)
+    Low   // Informational events (tickets, capacity, state changes)
+};
+
+/**
+ * @brief Number of event bus lanes
+ */
+inline constexpr size_t EVENT_PRIORITY_COUNT = 2;
+
+/**
+ * @brief Delivery lane of every event type, indexed by eventTypeIndex()
+ */
+inline constexpr std::array<EventPriority, EVENT_TYPE_COUNT> EVENT_TYPE_PRIORITIES = {
+#define PARKING_EVENT_PRIORITY(name, category, priority, payload, level) EventPriority::priority,
+    PARKING_EVENT_TYPES(PARKING_EVENT_PRIORITY)
+#undef PARKING_EVENT_PRIORITY
+};
+
+/**
+ * @brief Get the delivery lane of an event type
+ */
+constexpr EventPriority eventPriority(EventType type) {
+    const size_t index = eventTypeIndex(type);
+    return index < EVENT_TYPE_COUNT ? EVENT_TYPE_PRIORITIES[index] : EventPriority::Low;
+}
+
+/**
+ * @brief Level source name of every event type ("None" if not level-style)
+ *
+ * A level source reports a binary level through a pair of event types (light
+ * barrier blocked/cleared). The event bus can coalesce queued events of one
+ * source instead of queueing every edge of a flickering sensor.
+ */
+inline constexpr std::array<std::string_view, EVENT_TYPE_COUNT> EVENT_TYPE_LEVEL_NAMES = {
+#define PARKING_EVENT_LEVEL(name, category, priority, payload, level) #level,
+    PARKING_EVENT_TYPES(PARKING_EVENT_LEVEL)
+#undef PARKING_EVENT_LEVEL
+};
+
+/**
+ * @brief Check if an event type is the first one naming its level source
+ */
+constexpr bool isFirstOfLevelSource(size_t index) {
+    if (EVENT_TYPE_LEVEL_NAMES[index] == "None") {
+        return false;
+    }
+    for (size_t i = 0; i < index; i++) {
+        if (EVENT_TYPE_LEVEL_NAMES[i] == EVENT_TYPE_LEVEL_NAMES[index]) {
+            return false;
+        }
+    }
+    return true;
+}
+
+/**
+ * @brief Number of level-style event sources (distinct level names in the registry)
+ */
+inline constexpr size_t LEVEL_SOURCE_COUNT = [] {
+    size_t count = 0;
+    for (size_t i = 0; i < EVENT_TYPE_COUNT; i++) {
+        count += isFirstOfLevelSource(i) ? 1 : 0;
+    }
+    return count;
+}();
+
+/**
+ * @brief levelSourceIndex() result for event types that are not level-style
+ */
+inline constexpr size_t NO_LEVEL_SOURCE = LEVEL_SOURCE_COUNT;
+
+/**
+ * @brief Level source of every event type, numbered in registry order
+ */
+inline constexpr std::array<size_t, EVENT_TYPE_COUNT> EVENT_TYPE_LEVEL_SOURCES = [] {
+    std::array<size_t, EVENT_TYPE_COUNT> sources{};
+    size_t next = 0;
+    for (size_t i = 0; i < EVENT_TYPE_COUNT; i++) {
+        sources[i] = NO_LEVEL_SOURCE;
+        if (isFirstOfLevelSource(i)) {
+            sources[i] = next++;
+            continue;
+        }
+        for (size_t j = 0; j < i; j++) {
+            if (EVENT_TYPE_LEVEL_NAMES[i] != "None" && EVENT_TYPE_LEVEL_NAMES[j] == EVENT_TYPE_LEVEL_NAMES[i]) {
+                sources[i] = sources[j];
+                break;
+            }
+        }
+    }
+    return sources;
+}();
+
+static_assert(
+    [] {
+        std::array<size_t, LEVEL_SOURCE_COUNT + 1> types{};
+        for (size_t source : EVENT_TYPE_LEVEL_SOURCES) {
+            types[source]++;
+        }
+        for (size_t source = 0; source < LEVEL_SOURCE_COUNT; source++) {
+            if (types[source] != 2) {
+                return false;
+            }
+        }
+        return true;
+    }(),
+    "Every level source in PARKING_EVENT_TYPES must name exactly two event types");
+
+/**
+ * @brief Get the level source of an event type
+ */
+constexpr size_t levelSourceIndex(EventType type) {
+    const size_t index = eventTypeIndex(type);
+    return index < EVENT_TYPE_COUNT ? EVENT_TYPE_LEVEL_SOURCES[index] : NO_LEVEL_SOURCE;
+}
+
+/**
+ * @brief Bitmask of event categories (combine EVENT_CATEGORY_* with |)
+ */
+using EventCategoryMask = uint8_t;
+
+inline constexpr EventCategoryMask EVENT_CATEGORY_HARDWARE = 0x01; // GPIO inputs
+inline constexpr EventCategoryMask EVENT_CATEGORY_SYSTEM = 0x02;   // Capacity and tickets
+inline constexpr EventCategoryMask EVENT_CATEGORY_STATE = 0x04;    // Barrier and car state changes
+inline constexpr EventCategoryMask EVENT_CATEGORY_TIMER = 0x08;    // Timeouts
+inline constexpr EventCategoryMask EVENT_CATEGORY_ALL = 0x0F;
+inline constexpr size_t EVENT_CATEGORY_COUNT = 4; // Bits in EVENT_CATEGORY_ALL
+
+/**
+ * @brief Category of every event type, indexed by eventTypeIndex()
+ */
+inline constexpr std::array<EventCategoryMask, EVENT_TYPE_COUNT> EVENT_TYPE_CATEGORIES = {
+#define PARKING_EVENT_CATEGORY(name, category, priority, payload, level) EVENT_CATEGORY_##category,
+    PARKING_EVENT_TYPES(PARKING_EVENT_CATEGORY)
+#undef PARKING_EVENT_CATEGORY
+};
+
+/**
+ * @brief Get the category of an event type (exactly one bit set)
+ */
+constexpr EventCategoryMask eventCategory(EventType type) {
+    const size_t index = eventTypeIndex(type);
+    return index < EVENT_TYPE_COUNT ? EVENT_TYPE_CATEGORIES[index] : 0;
+}
+
+/**
+ * @brief Get string representation of a single event category bit
+ */
+inline const char* eventCategoryToString(EventCategoryMask category) {
+    switch (category) {
+        case EVENT_CATEGORY_HARDWARE:
+            return "hardware";
+        case EVENT_CATEGORY_SYSTEM:
+            return "system";
+        case EVENT_CATEGORY_STATE:
+            return "state";
+        case EVENT_CATEGORY_TIMER:
+            return "timer";
+        default:
+            return "unknown";
+    }
+}
+
+/**
+ * @brief Number of event sources (lanes) that can be routed and coalesced separately
+ *
+ * Event::source identifies the physical lane that produced an event (0 for a
+ * single-lane garage). Subscribers can ask for one source only; dispatch to
+ * them is an index into a per-source vector, independent of the lane count.
+ */
+inline constexpr size_t MAX_EVENT_SOURCES = 8;
+
+/**
+ * @brief Subscription source that receives events of every source
+ */
+inline constexpr uint8_t EVENT_SOURCE_ANY = 0xFF;
+
 /**
  * @brief Event payload types
+ *
+ * Scalars travel inside the event; larger data (plates, fees, reader frames)
+ * is allocated from a PayloadPool and carried as a PayloadRef handle.
+ */
+using EventPayload = std::variant<std::monostate, uint32_t, bool, PayloadRef>;
+
+/**
+ * @brief Alternative index of T in EventPayload
+ */
+template <typename T, size_t Index = 0>
+constexpr size_t eventPayloadIndexOf() {
+    if constexpr (std::is_same_v<T, std::variant_alternative_t<Index, EventPayload>>) {
+        return Index;
+    } else {
+        return eventPayloadIndexOf<T, Index + 1>();
+    }
+}
+
+/**
+ * @brief Payload discriminator (PackedEvent wire format, payload registry)
+ *
+ * Values match the alternative index of EventPayload.
+ */
+enum class PayloadTag : uint8_t {
+    None,   // std::monostate
+    UInt32, // uint32_t
+    Bool,   // bool
+    Pooled  // PayloadRef (payload is the handle)
+};
+
+static_assert(eventPayloadIndexOf<uint32_t>() == static_cast<size_t>(PayloadTag::UInt32) &&
+                  eventPayloadIndexOf<bool>() == static_cast<size_t>(PayloadTag::Bool) &&
+                  eventPayloadIndexOf<PayloadRef>() == static_cast<size_t>(PayloadTag::Pooled),
+              "PayloadTag must match the EventPayload alternatives");
+
+/**
+ * @brief Declared payload type of an event type (std::monostate for none)
+ */
+template <EventType T>
+struct EventPayloadTraits;
+
+#define PARKING_EVENT_PAYLOAD(name, category, priority, payload, level) \
+    template <>                                                          \
+    struct EventPayloadTraits<EventType::name> {                         \
+        using Type = payload;                                            \
+    };
+PARKING_EVENT_TYPES(PARKING_EVENT_PAYLOAD)
+#undef PARKING_EVENT_PAYLOAD
+
+template <EventType T>
+using EventPayloadType = typename EventPayloadTraits<T>::Type;
+
+/**
+ * @brief Variant index of the declared payload of every event type
  */
-using EventPayload = std::variant<std::monostate, uint32_t, bool>;
+inline constexpr std::array<size_t, EVENT_TYPE_COUNT> EVENT_TYPE_PAYLOAD_INDICES = {
+#define PARKING_EVENT_PAYLOAD_INDEX(name, category, priority, payload, level) eventPayloadIndexOf<payload>(),
+    PARKING_EVENT_TYPES(PARKING_EVENT_PAYLOAD_INDEX)
+#undef PARKING_EVENT_PAYLOAD_INDEX
+};
 
 /**
  * @brief Event structure
@@ -46,60 +298,72 @@ struct Event {
     EventType type;
     uint64_t timestamp;
     EventPayload payload;
+    uint8_t source; // Lane that produced the event (< MAX_EVENT_SOURCES)
 
     Event()
         : type(EventType::EntryButtonPressed)
         , timestamp(0)
-        , payload(std::monostate{}) {}
+        , payload(std::monostate{})
+        , source(0) {}
 
-    Event(EventType t, uint64_t ts = 0, EventPayload p = std::monostate{})
+    Event(EventType t, uint64_t ts = 0, EventPayload p = std::monostate{}, uint8_t src = 0)
         : type(t)
         , timestamp(ts)
-        , payload(p) {}
+        , payload(std::move(p))
+        , source(src) {}
 };
 
 /**
- * @brief Get string representation of EventType
+ * @brief Get the payload of an event as the type declared for T
+ *
+ * Checked at compile time: asking for the payload of an event type that has
+ * none does not compile. An event built with a different payload yields a
+ * value-initialized result instead of throwing like std::get.
+ */
+template <EventType T>
+constexpr EventPayloadType<T> eventPayload(const Event& event) {
+    static_assert(!std::is_same_v<EventPayloadType<T>, std::monostate>, "Event type declares no payload");
+    const auto* value = std::get_if<EventPayloadType<T>>(&event.payload);
+    return value ? *value : EventPayloadType<T>{};
+}
+
+/**
+ * @brief Build the declared payload of a type from an integer (console input)
  */
-inline const char* eventTypeToString(EventType type) {
-    switch (type) {
-        case EventType::EntryButtonPressed:
-            return "EntryButtonPressed";
-        case EventType::EntryButtonReleased:
-            return "EntryButtonReleased";
-        case EventType::EntryLightBarrierBlocked:
-            return "EntryLightBarrierBlocked";
-        case EventType::EntryLightBarrierCleared:
-            return "EntryLightBarrierCleared";
-        case EventType::ExitLightBarrierBlocked:
-            return "ExitLightBarrierBlocked";
-        case EventType::ExitLightBarrierCleared:
-            return "ExitLightBarrierCleared";
-        case EventType::CapacityAvailable:
-            return "CapacityAvailable";
-        case EventType::CapacityFull:
-            return "CapacityFull";
-        case EventType::TicketIssued:
-            return "TicketIssued";
-        case EventType::TicketValidated:
-            return "TicketValidated";
-        case EventType::TicketRejected:
-            return "TicketRejected";
-        case EventType::EntryBarrierOpened:
-            return "EntryBarrierOpened";
-        case EventType::EntryBarrierClosed:
-            return "EntryBarrierClosed";
-        case EventType::ExitBarrierOpened:
-            return "ExitBarrierOpened";
-        case EventType::ExitBarrierClosed:
-            return "ExitBarrierClosed";
-        case EventType::CarEnteredParking:
-            return "CarEnteredParking";
-        case EventType::CarExitedParking:
-            return "CarExitedParking";
-        case EventType::BarrierTimeout:
-            return "BarrierTimeout";
+inline EventPayload makeEventPayload(EventType type, uint32_t value) {
+    const size_t index = eventTypeIndex(type);
+    const size_t tag = index < EVENT_TYPE_COUNT ? EVENT_TYPE_PAYLOAD_INDICES[index] : 0;
+    switch (static_cast<PayloadTag>(tag)) {
+        case PayloadTag::UInt32:
+            return value;
+        case PayloadTag::Bool:
+            return value != 0;
         default:
-            return "Unknown";
+            return std::monostate{};
     }
 }
+
+/**
+ * @brief Check if an event type declares a payload
+ */
+constexpr bool eventHasPayload(EventType type) {
+    const size_t index = eventTypeIndex(type);
+    return index < EVENT_TYPE_COUNT && EVENT_TYPE_PAYLOAD_INDICES[index] != static_cast<size_t>(PayloadTag::None);
+}
+
+/**
+ * @brief Name of every event type, indexed by eventTypeIndex()
+ */
+inline constexpr std::array<const char*, EVENT_TYPE_COUNT> EVENT_TYPE_NAMES = {
+#define PARKING_EVENT_NAME(name, category, priority, payload, level) #name,
+    PARKING_EVENT_TYPES(PARKING_EVENT_NAME)
+#undef PARKING_EVENT_NAME
+};
+
+/**
+ * @brief Get string representation of EventType
+ */
+constexpr const char* eventTypeToString(EventType type) {
+    const size_t index = eventTypeIndex(type);
+    return index < EVENT_TYPE_COUNT ? EVENT_TYPE_NAMES[index] : "Unknown";
+}
@@ -0,0 +1,73 @@
+#pragma once
+
+#include "Event.h"
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+/**
+ * @brief What the event bus does with an event whose lane is full
+ */
+enum class OverflowPolicy : uint8_t {
+    DropNewest,       // Discard the event being published (default)
+    DropOldest,       // Discard the oldest queued event of the same lane
+    BlockWithTimeout, // Wait up to the bus block timeout for a free slot (task context only)
+    OverwriteLatest   // Park the event; a newer event of the same type replaces it
+};
+
+/**
+ * @brief Get string representation of OverflowPolicy
+ */
+inline const char* overflowPolicyToString(OverflowPolicy policy) {
+    switch (policy) {
+        case OverflowPolicy::DropNewest:
+            return "drop-newest";
+        case OverflowPolicy::DropOldest:
+            return "drop-oldest";
+        case OverflowPolicy::BlockWithTimeout:
+            return "block";
+        case OverflowPolicy::OverwriteLatest:
+            return "overwrite";
+        default:
+            return "unknown";
+    }
+}
+
+/**
+ * @brief Counters of one event type
+ */
+struct EventTypeStats {
+    uint32_t published = 0;     // Publish attempts
+    uint32_t dropped = 0;       // Events lost (rejected, evicted or overwritten)
+    uint32_t coalesced = 0;     // Events merged into an already queued level event
+    uint32_t inlined = 0;       // Events dispatched inline, without the queue (see setInlineDispatch())
+    uint32_t queued = 0;        // Currently waiting for dispatch
+    uint32_t highWatermark = 0; // Peak of queued
+};
+
+/**
+ * @brief Fill level of one priority lane
+ */
+struct EventLaneStats {
+    size_t capacity = 0;
+    size_t queued = 0;
+    size_t highWatermark = 0; // Peak of queued
+};
+
+/**
+ * @brief Queue-depth priority boosts of the event loop task
+ */
+struct EventLoopBoostStats {
+    bool active = false;    // Loop task currently runs at the boosted priority
+    uint32_t boosts = 0;    // Times the priority was raised
+    uint64_t boostedUs = 0; // Total time spent boosted, including the current boost
+};
+
+/**
+ * @brief Snapshot of event bus counters
+ */
+struct EventBusStats {
+    std::array<EventTypeStats, EVENT_TYPE_COUNT> types{};  // Indexed by eventTypeIndex()
+    std::array<EventLaneStats, EVENT_PRIORITY_COUNT> lanes{}; // Indexed by EventPriority
+    EventLoopBoostStats boost{};
+};
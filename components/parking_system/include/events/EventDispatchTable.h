@@ -0,0 +1,286 @@
+#pragma once
+
+#include "Event.h"
+#include "EventHandler.h"
+#include "HandlerProfile.h"
+#include "PayloadFilter.h"
+#include "esp_timer.h"
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <vector>
+
+/**
+ * @brief Dense subscriber table indexed by EventType
+ *
+ * Holds one slot per event type, sized at compile time from EVENT_TYPE_COUNT.
+ * Lookup is a plain array index (no tree walk) and the handlers of a slot are
+ * stored contiguously, in subscription order.
+ *
+ * Handlers for one event source (lane) stay in the slot, in subscription
+ * order with the handlers for every lane. Each slot also keeps, per source,
+ * the positions of the handlers that receive that source's events, so routing
+ * an event to its lane is an index, whatever the number of lanes, and the
+ * handlers of other lanes are never visited. Handlers with a PayloadFilter are indexed separately: equality filters in
+ * a vector sorted by value (binary search), range and mask filters in a short
+ * list checked before the call. Non-matching handlers are never invoked.
+ *
+ * Category handlers (addCategory()) live outside the per-type slots. Each slot
+ * has a precomputed bitmask of the category handlers that match it, so an
+ * event with no category subscriber costs one zero check, and a category
+ * handler does not bloat every slot vector.
+ *
+ * A handler added with a HandlerProfile is timed around every call; the
+ * profile is not owned by the table.
+ *
+ * Not thread-safe - the owning event bus is responsible for synchronization.
+ */
+class EventDispatchTable {
+  public:
+    using Handler = EventHandler;
+
+    /**
+     * @brief One subscribed handler
+     */
+    struct Subscription {
+        Handler handler;
+        HandlerProfile* profile = nullptr; // Run time counters, nullptr = not timed
+        uint8_t source = EVENT_SOURCE_ANY;  // Lane filter, EVENT_SOURCE_ANY for all lanes
+    };
+
+    /**
+     * @brief Append handler to the slot of an event type
+     * @param profile Optional run time counters (must outlive the table)
+     * @param filter Payload filter, handler is only called for matching events
+     * @param source Lane to receive events from, EVENT_SOURCE_ANY for all
+     */
+    void add(EventType type, Handler handler, HandlerProfile* profile = nullptr, PayloadFilter filter = {},
+             uint8_t source = EVENT_SOURCE_ANY) {
+        const size_t index = eventTypeIndex(type);
+        Subscription subscription{std::move(handler), profile, source};
+        if (!filter.isActive()) {
+            auto& slot = m_slots[index];
+            auto& routed = m_routed[index];
+            const auto position = static_cast<uint16_t>(slot.size());
+            slot.push_back(std::move(subscription));
+            if (source == EVENT_SOURCE_ANY) {
+                for (auto& lane : routed) {
+                    lane.push_back(position);
+                }
+                return;
+            }
+
+            // A new lane list starts with the handlers for every lane subscribed so far
+            while (routed.size() <= source) {
+                auto& lane = routed.emplace_back();
+                for (uint16_t i = 0; i < position; i++) {
+                    if (slot[i].source == EVENT_SOURCE_ANY) {
+                        lane.push_back(i);
+                    }
+                }
+            }
+            routed[source].push_back(position);
+            return;
+        }
+
+        FilteredSubscription filtered{filter, std::move(subscription)};
+        if (filter.kind == PayloadFilter::Kind::Equal) {
+            // upper_bound keeps subscription order among equal values
+            auto& equal = m_equalFilters[index];
+            auto position = std::upper_bound(equal.begin(), equal.end(), filter.first,
+                                             [](uint32_t value, const FilteredSubscription& entry) {
+                                                 return value < entry.filter.first;
+                                             });
+            equal.insert(position, std::move(filtered));
+        } else {
+            m_otherFilters[index].push_back(std::move(filtered));
+        }
+    }
+
+    /**
+     * @brief Maximum number of category handlers per table
+     */
+    static constexpr size_t MAX_CATEGORY_HANDLERS = 32;
+
+    /**
+     * @brief Append a handler for all event types in a category mask
+     * @param profile Optional run time counters (must outlive the table)
+     * @return false if MAX_CATEGORY_HANDLERS is reached
+     */
+    bool addCategory(EventCategoryMask categories, Handler handler, HandlerProfile* profile = nullptr,
+                     uint8_t source = EVENT_SOURCE_ANY) {
+        if (m_categoryHandlers.size() >= MAX_CATEGORY_HANDLERS) {
+            return false;
+        }
+
+        const uint32_t bit = 1u << m_categoryHandlers.size();
+        m_categoryHandlers.push_back(Subscription{std::move(handler), profile, source});
+        for (size_t i = 0; i < EVENT_TYPE_COUNT; i++) {
+            if (eventCategory(static_cast<EventType>(i)) & categories) {
+                m_categoryMatches[i] |= bit;
+            }
+        }
+        return true;
+    }
+
+    /**
+     * @brief Get unfiltered handlers subscribed to an event type, for every lane
+     */
+    [[nodiscard]] const std::vector<Subscription>& subscriptions(EventType type) const {
+        return m_slots[eventTypeIndex(type)];
+    }
+
+    /**
+     * @brief Check if dispatch() would invoke at least one handler for the event
+     *
+     * Same routing as dispatch() without calling anything, so a forwarder can
+     * skip events no handler wants.
+     */
+    [[nodiscard]] bool wants(const Event& event) const {
+        const size_t index = eventTypeIndex(event.type);
+        if (index >= EVENT_TYPE_COUNT) {
+            return false;
+        }
+
+        const auto& routed = m_routed[index];
+        if (event.source < routed.size() ? !routed[event.source].empty()
+                                         : std::any_of(m_slots[index].begin(), m_slots[index].end(),
+                                                       [](const Subscription& subscription) {
+                                                           return subscription.source == EVENT_SOURCE_ANY;
+                                                       })) {
+            return true;
+        }
+
+        const auto& equal = m_equalFilters[index];
+        const auto& other = m_otherFilters[index];
+        uint32_t value = 0;
+        if ((!equal.empty() || !other.empty()) && filterValue(event.payload, value)) {
+            auto first = std::lower_bound(equal.begin(), equal.end(), value,
+                                          [](const FilteredSubscription& entry, uint32_t v) {
+                                              return entry.filter.first < v;
+                                          });
+            for (auto it = first; it != equal.end() && it->filter.first == value; ++it) {
+                if (matchesSource(it->subscription, event)) {
+                    return true;
+                }
+            }
+            for (const auto& entry : other) {
+                if (entry.filter.matches(value) && matchesSource(entry.subscription, event)) {
+                    return true;
+                }
+            }
+        }
+
+        for (uint32_t matches = m_categoryMatches[index]; matches != 0; matches &= matches - 1) {
+            if (matchesSource(m_categoryHandlers[std::countr_zero(matches)], event)) {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    /**
+     * @brief Invoke all handlers subscribed to the event's type or category
+     * @param overrun Set to the profile of a handler that exceeded its budget (unchanged if none)
+     * @return Number of handlers invoked (0 for unknown types)
+     */
+    size_t dispatch(const Event& event, HandlerProfile** overrun = nullptr) const {
+        const size_t index = eventTypeIndex(event.type);
+        if (index >= EVENT_TYPE_COUNT) {
+            return 0;
+        }
+
+        // Handlers for every lane and for the event's own lane, in subscription order
+        const auto& slot = m_slots[index];
+        const auto& routed = m_routed[index];
+        size_t invoked = 0;
+        int64_t start = 0;
+        if (event.source < routed.size()) {
+            for (uint16_t position : routed[event.source]) {
+                invoke(slot[position], event, start, overrun);
+            }
+            invoked = routed[event.source].size();
+        } else {
+            // No lane handlers for this source: only the handlers for every lane match
+            for (const auto& subscription : slot) {
+                if (subscription.source == EVENT_SOURCE_ANY) {
+                    invoke(subscription, event, start, overrun);
+                    invoked++;
+                }
+            }
+        }
+
+        // Filtered handlers run after unfiltered ones: equality matches, then range/mask matches
+        const auto& equal = m_equalFilters[index];
+        const auto& other = m_otherFilters[index];
+        uint32_t value = 0;
+        if ((!equal.empty() || !other.empty()) && filterValue(event.payload, value)) {
+            auto first = std::lower_bound(equal.begin(), equal.end(), value,
+                                          [](const FilteredSubscription& entry, uint32_t v) {
+                                              return entry.filter.first < v;
+                                          });
+            for (auto it = first; it != equal.end() && it->filter.first == value; ++it) {
+                if (matchesSource(it->subscription, event)) {
+                    invoke(it->subscription, event, start, overrun);
+                    invoked++;
+                }
+            }
+            for (const auto& entry : other) {
+                if (entry.filter.matches(value) && matchesSource(entry.subscription, event)) {
+                    invoke(entry.subscription, event, start, overrun);
+                    invoked++;
+                }
+            }
+        }
+
+        // Category handlers run after the type's own handlers, in subscription order
+        for (uint32_t matches = m_categoryMatches[index]; matches != 0; matches &= matches - 1) {
+            const Subscription& subscription = m_categoryHandlers[std::countr_zero(matches)];
+            if (matchesSource(subscription, event)) {
+                invoke(subscription, event, start, overrun);
+                invoked++;
+            }
+        }
+        return invoked;
+    }
+
+  private:
+    struct FilteredSubscription {
+        PayloadFilter filter;
+        Subscription subscription;
+    };
+
+    static bool matchesSource(const Subscription& subscription, const Event& event) {
+        return subscription.source == EVENT_SOURCE_ANY || subscription.source == event.source;
+    }
+
+    static void invoke(const Subscription& subscription, const Event& event, int64_t& start,
+                       HandlerProfile** overrun) {
+        if (!subscription.handler) {
+            return;
+        }
+        if (!subscription.profile) {
+            subscription.handler(event);
+            start = 0;
+            return;
+        }
+
+        // Consecutive timed handlers share one clock read between them
+        if (start == 0) {
+            start = esp_timer_get_time();
+        }
+        subscription.handler(event);
+        int64_t end = esp_timer_get_time();
+        if (subscription.profile->record(static_cast<uint32_t>(end - start)) && overrun) {
+            *overrun = subscription.profile;
+        }
+        start = end;
+    }
+
+    std::array<std::vector<Subscription>, EVENT_TYPE_COUNT> m_slots{};                // Unfiltered, all lanes
+    std::array<std::vector<std::vector<uint16_t>>, EVENT_TYPE_COUNT> m_routed{};      // [type][source] slot positions
+    std::array<std::vector<FilteredSubscription>, EVENT_TYPE_COUNT> m_equalFilters{}; // Sorted by filter value
+    std::array<std::vector<FilteredSubscription>, EVENT_TYPE_COUNT> m_otherFilters{}; // Range and mask filters
+    std::vector<Subscription> m_categoryHandlers;
+    std::array<uint32_t, EVENT_TYPE_COUNT> m_categoryMatches{}; // Bit i: m_categoryHandlers[i] matches the type
+};
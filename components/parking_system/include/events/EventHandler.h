@@ -0,0 +1,17 @@
+#pragma once
+
+#include "Event.h"
+#include "InlineDelegate.h"
+
+/**
+ * @brief Inline capture storage of an event handler (four pointers)
+ *
+ * Enough for `[this]` and small reference captures; larger captures fail to
+ * compile instead of silently heap-allocating.
+ */
+inline constexpr size_t EVENT_HANDLER_CAPACITY = 4 * sizeof(void*);
+
+/**
+ * @brief Event handler callback (non-allocating, see InlineDelegate)
+ */
+using EventHandler = InlineDelegate<void(const Event&), EVENT_HANDLER_CAPACITY>;
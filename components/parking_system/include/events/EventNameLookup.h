@@ -0,0 +1,93 @@
+#pragma once
+
+#include "Event.h"
+#include <array>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+
+/**
+ * @brief Compile-time perfect hash from event names to EventType
+ *
+ * The table is built from EVENT_TYPE_NAMES at compile time: a seeded FNV-1a
+ * hash is searched for a seed that maps every registered name to its own
+ * slot. A lookup is one hash of the input, one slot read and one string
+ * compare to reject names that are not registered.
+ */
+namespace event_name_lookup {
+
+/** @brief Slots in the hash table (load factor <= 0.5 keeps the seed search short) */
+inline constexpr size_t TABLE_SIZE = std::bit_ceil(EVENT_TYPE_COUNT) * 2;
+
+/** @brief Marker for an unused slot */
+inline constexpr uint8_t EMPTY_SLOT = 0xFF;
+
+static_assert(EVENT_TYPE_COUNT < EMPTY_SLOT, "Event type index must fit a slot");
+
+constexpr uint32_t hash(std::string_view name, uint32_t seed) {
+    uint32_t h = 2166136261u ^ seed;
+    for (char c : name) {
+        h ^= static_cast<uint8_t>(c);
+        h *= 16777619u;
+    }
+    return h ^ (h >> 15);
+}
+
+constexpr size_t slotOf(std::string_view name, uint32_t seed) {
+    return hash(name, seed) & (TABLE_SIZE - 1);
+}
+
+constexpr bool isPerfect(uint32_t seed) {
+    std::array<bool, TABLE_SIZE> used{};
+    for (const char* name : EVENT_TYPE_NAMES) {
+        size_t slot = slotOf(name, seed);
+        if (used[slot]) {
+            return false;
+        }
+        used[slot] = true;
+    }
+    return true;
+}
+
+constexpr uint32_t findSeed() {
+    for (uint32_t seed = 1; seed < 100000; seed++) {
+        if (isPerfect(seed)) {
+            return seed;
+        }
+    }
+    return 0;
+}
+
+/** @brief Seed that hashes every registered name to a distinct slot */
+inline constexpr uint32_t SEED = findSeed();
+static_assert(SEED != 0, "No collision-free seed found - raise TABLE_SIZE");
+
+constexpr std::array<uint8_t, TABLE_SIZE> buildTable() {
+    std::array<uint8_t, TABLE_SIZE> table{};
+    for (auto& slot : table) {
+        slot = EMPTY_SLOT;
+    }
+    for (size_t i = 0; i < EVENT_TYPE_COUNT; i++) {
+        table[slotOf(EVENT_TYPE_NAMES[i], SEED)] = static_cast<uint8_t>(i);
+    }
+    return table;
+}
+
+/** @brief Event type index per slot */
+inline constexpr std::array<uint8_t, TABLE_SIZE> TABLE = buildTable();
+
+} // namespace event_name_lookup
+
+/**
+ * @brief Look up an event type by its name (case-sensitive, as in traces)
+ * @return true and the type in out if name is a registered event
+ */
+constexpr bool eventTypeFromName(std::string_view name, EventType& out) {
+    const uint8_t index = event_name_lookup::TABLE[event_name_lookup::slotOf(name, event_name_lookup::SEED)];
+    if (index == event_name_lookup::EMPTY_SLOT || name != EVENT_TYPE_NAMES[index]) {
+        return false;
+    }
+    out = static_cast<EventType>(index);
+    return true;
+}
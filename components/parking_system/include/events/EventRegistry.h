@@ -0,0 +1,42 @@
+#pragma once
+
+/**
+ * @brief Single source of truth for all event types
+ *
+ * One X(name, category, priority, payload, level) entry per event type:
+ * - name:     EventType enumerator, also its console/trace name
+ * - category: EVENT_CATEGORY_<category> bit (HARDWARE, SYSTEM, STATE, TIMER)
+ * - priority: EventPriority lane (High for sensor and control events)
+ * - payload:  Payload alternative the event carries (std::monostate for none)
+ * - level:    Level source the event reports an edge of (None if not
+ *             level-style); each level source names exactly two event types
+ *
+ * Event.h expands the list into the EventType enum, EVENT_TYPE_COUNT, the
+ * name, category, priority, payload and level source tables;
+ * EventNameLookup.h builds the perfect-hash name lookup from it. Add new
+ * events here only, at the end of their group - enumerator values are table
+ * indices and appear in traces.
+ */
+#define PARKING_EVENT_TYPES(X)                                                     \
+    /* Hardware events (from GPIO interrupts) */                                   \
+    X(EntryButtonPressed, HARDWARE, High, std::monostate, None)                    \
+    X(EntryButtonReleased, HARDWARE, High, std::monostate, None)                   \
+    X(EntryLightBarrierBlocked, HARDWARE, High, std::monostate, EntryLightBarrier) \
+    X(EntryLightBarrierCleared, HARDWARE, High, std::monostate, EntryLightBarrier) \
+    X(ExitLightBarrierBlocked, HARDWARE, High, std::monostate, ExitLightBarrier)   \
+    X(ExitLightBarrierCleared, HARDWARE, High, std::monostate, ExitLightBarrier)   \
+    /* System events */                                                            \
+    X(CapacityAvailable, SYSTEM, Low, std::monostate, None)                        \
+    X(CapacityFull, SYSTEM, Low, std::monostate, None)                             \
+    X(TicketIssued, SYSTEM, Low, uint32_t, None)                                   \
+    X(TicketValidated, SYSTEM, Low, uint32_t, None)                                \
+    X(TicketRejected, SYSTEM, Low, std::monostate, None)                           \
+    /* State events (for logging/monitoring) */                                    \
+    X(EntryBarrierOpened, STATE, Low, std::monostate, None)                        \
+    X(EntryBarrierClosed, STATE, Low, std::monostate, None)                        \
+    X(ExitBarrierOpened, STATE, Low, std::monostate, None)                         \
+    X(ExitBarrierClosed, STATE, Low, std::monostate, None)                         \
+    X(CarEnteredParking, STATE, Low, uint32_t, None)                               \
+    X(CarExitedParking, STATE, Low, uint32_t, None)                                \
+    /* Timer events */                                                             \
+    X(BarrierTimeout, TIMER, High, std::monostate, None)
@@ -0,0 +1,119 @@
+#pragma once
+
+#include "PackedEvent.h"
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+/**
+ * @brief What happened to a traced event
+ */
+enum class TraceKind : uint8_t {
+    Published,
+    Dropped,
+    Dispatched
+};
+
+/**
+ * @brief Get string representation of TraceKind
+ */
+inline const char* traceKindToString(TraceKind kind) {
+    switch (kind) {
+        case TraceKind::Published:
+            return "published";
+        case TraceKind::Dropped:
+            return "dropped";
+        case TraceKind::Dispatched:
+            return "dispatched";
+        default:
+            return "unknown";
+    }
+}
+
+/**
+ * @brief One flight recorder entry (16 bytes)
+ */
+struct TraceEntry {
+    uint8_t type;          // EventType
+    TraceKind kind;
+    uint8_t payloadTag;    // PayloadTag
+    uint8_t source;        // Event::source
+    uint32_t payload;      // Same encoding as PackedEvent::payload
+    uint32_t publishTime;  // Low 32 bits of Event::timestamp (us)
+    uint32_t dispatchTime; // Low 32 bits of dispatch time (us), 0 unless dispatched
+};
+
+static_assert(sizeof(TraceEntry) == 16, "TraceEntry must stay 16 bytes");
+
+/**
+ * @brief Always-on event flight recorder
+ *
+ * Fixed-size binary ring of the most recent bus activity for post-mortem
+ * analysis (console `trace` command). Recording is one relaxed fetch_add and
+ * a 16-byte store, safe from tasks and ISRs; nothing is formatted until the
+ * ring is dumped. Entries being overwritten while a snapshot is taken may be
+ * torn, which is acceptable for a diagnostic history.
+ */
+class EventTraceRecorder {
+  public:
+    /**
+     * @brief Number of entries kept (power of two)
+     */
+    static constexpr size_t CAPACITY = 256;
+
+    /**
+     * @brief Record an event
+     * @param kind What happened
+     * @param event Event in queue format (publish timestamp included)
+     * @param dispatchTime Low 32 bits of dispatch time, 0 if not dispatched
+     */
+    void record(TraceKind kind, const PackedEvent& event, uint32_t dispatchTime = 0) {
+        uint32_t index = m_next.fetch_add(1, std::memory_order_relaxed);
+        TraceEntry& entry = m_entries[index & (CAPACITY - 1)];
+        entry.type = event.type;
+        entry.kind = kind;
+        entry.payloadTag = event.payloadTag;
+        entry.source = event.source;
+        entry.payload = event.payload;
+        entry.publishTime = event.timestamp;
+        entry.dispatchTime = dispatchTime;
+    }
+
+    /**
+     * @brief Copy the most recent entries, oldest first
+     * @param out Destination buffer
+     * @param maxCount Size of destination buffer
+     * @return Number of entries copied
+     */
+    size_t snapshot(TraceEntry* out, size_t maxCount) const {
+        uint32_t next = m_next.load(std::memory_order_acquire);
+        size_t count = std::min({static_cast<size_t>(next), CAPACITY, maxCount});
+        for (size_t i = 0; i < count; i++) {
+            out[i] = m_entries[(next - count + i) & (CAPACITY - 1)];
+        }
+        return count;
+    }
+
+    /**
+     * @brief Get number of entries recorded since start or clear()
+     */
+    [[nodiscard]] uint32_t recordedCount() const {
+        return m_next.load(std::memory_order_relaxed);
+    }
+
+    /**
+     * @brief Forget all entries
+     */
+    void clear() {
+        m_next.store(0, std::memory_order_release);
+    }
+
+  private:
+    std::array<TraceEntry, CAPACITY> m_entries{};
+    std::atomic<uint32_t> m_next{0};
+};
+
+static_assert((EventTraceRecorder::CAPACITY & (EventTraceRecorder::CAPACITY - 1)) == 0,
+              "Trace capacity must be a power of two");
@@ -1,35 +1,116 @@
 #pragma once
 
+#include "AsyncEventWorker.h"
+#include "EventBusStats.h"
+#include "EventDispatchTable.h"
+#include "EventTraceRecorder.h"
+#include "LatencyHistogram.h"
 #include "IEventBus.h"
+#include "IsrEventRing.h"
+#include "PackedEvent.h"
 #include "freertos/FreeRTOS.h"
 #include "freertos/queue.h"
 #include "freertos/semphr.h"
 #include "freertos/task.h"
-#include <map>
+#include "esp_timer.h"
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <memory>
 #include <vector>
 
+/**
+ * @brief Queue-depth thresholds for raising the event loop task's priority
+ */
+struct PriorityBoostConfig {
+    size_t highWater = 0;      // Queued events (both lanes) that trigger the boost, 0 = disabled
+    size_t lowWater = 0;       // Base priority is restored once the backlog is at or below this
+    UBaseType_t priority = 10; // Priority of the loop task while boosted
+};
+
 /**
  * @brief FreeRTOS implementation of event bus
  *
- * Thread-safe event bus using FreeRTOS queue and mutex.
+ * Thread-safe event bus using FreeRTOS queues and mutex.
+ * Events travel through the queues as 12-byte PackedEvent items.
+ *
+ * Each EventPriority lane has its own queue with its own capacity. Consumers
+ * always drain the high lane (sensor and control events) before the low lane
+ * (informational events), so a flood of monitoring events can neither fill
+ * the sensor queue nor delay its dispatch. Order is kept within a lane.
+ * Publishers signal a shared wakeup semaphore that consumers block on.
+ *
+ * When a lane is full the event type's OverflowPolicy decides what is lost.
+ * Drops are counted per event type instead of logged (only the first drop of
+ * a type is logged), and per-type and per-lane high-watermarks are kept so
+ * lane capacities can be sized from getStats().
+ *
+ * With coalescing enabled, a level-style event (see levelSourceIndex()) whose
+ * source still has an undispatched event queued on the same lane does not
+ * take another slot: it is merged into that source's level cell. The queued event keeps its
+ * position relative to other types and is dispatched as the first level of the
+ * run followed by the latest level, if different, so a flickering light
+ * barrier still produces a complete blocked/cleared pass.
+ *
+ * GPIO interrupts bypass the queues through IsrEventRing instances created
+ * with createIsrEventRing(). Consumers drain these rings before both lanes;
+ * with coalescing enabled a run of edges of a level-style ring is reduced the
+ * same way (button rings are always drained edge by edge).
+ *
+ * Events carry the lane that produced them (Event::source). A subscription
+ * with SubscribeOptions::source only receives events of that lane, found by
+ * index, so adding lanes does not wake up the gates of the other lanes.
+ *
+ * Slow observers subscribe with SubscribeOptions::async: they run on an
+ * AsyncEventWorker task with its own bounded queue, so they cannot delay the
+ * gate controllers on the event loop.
+ *
+ * Every published, dropped and dispatched event is recorded in an always-on
+ * EventTraceRecorder (see getTraceRecorder() and the `trace` console command).
+ *
+ * With setPriorityBoost() the loop task runs at its start priority until the
+ * backlog reaches the high-water mark, then at the boost priority until it is
+ * back at the low-water mark. A publisher raises the priority (the loop may be
+ * preempted right then); the consumer that drains the backlog restores it.
+ *
+ * Queue slots are reserved with a lock-free counter before sending, which
+ * lets publishBatch() queue a group of events all-or-nothing. Consumers
+ * drain up to EVENT_LOOP_BATCH_SIZE events per wakeup and dispatch them
+ * with a single table read.
  * Supports both asynchronous event publishing and synchronous event processing.
  * Can run its own event loop task for automatic event dispatching.
+ * Subscribers are kept in a dense EventDispatchTable, so dispatch is an O(1)
+ * array lookup per event.
+ *
+ * Once seal() has been called the active table is read-only and dispatch reads
+ * it without taking the mutex. Later subscriptions copy the table, add the
+ * handler and atomically swap the pointer (copy-on-write). Replaced tables are
+ * freed by the first swap that finds no dispatch in progress, since until then
+ * a dispatch may still be iterating them. Before seal(), dispatch takes the
+ * mutex only to pick up the table; subscriptions edit it in place while no
+ * dispatch is using it and copy it otherwise. Handlers never run with the mutex held, so a handler task
+ * deleted by stopEventLoop() cannot leave it locked.
  */
 class FreeRtosEventBus : public IEventBus {
   public:
     /**
      * @brief Construct event bus
-     * @param queueSize Maximum number of queued events
+     * @param highPriorityQueueSize Maximum number of queued sensor/control events
+     * @param lowPriorityQueueSize Maximum number of queued informational events
      */
-    explicit FreeRtosEventBus(size_t queueSize = 32);
+    explicit FreeRtosEventBus(size_t highPriorityQueueSize = 32, size_t lowPriorityQueueSize = 32);
     ~FreeRtosEventBus() override;
 
     // Prevent copying
     FreeRtosEventBus(const FreeRtosEventBus&) = delete;
     FreeRtosEventBus& operator=(const FreeRtosEventBus&) = delete;
 
-    void subscribe(EventType type, std::function<void(const Event&)> handler) override;
+    void subscribe(EventType type, EventHandler handler) override;
+    void subscribe(EventType type, EventHandler handler, const SubscribeOptions& options) override;
+    void subscribeCategory(EventCategoryMask categories, EventHandler handler) override;
+    void subscribeCategory(EventCategoryMask categories, EventHandler handler, const SubscribeOptions& options) override;
     void publish(const Event& event) override;
+    bool publishBatch(std::span<const Event> events) override;
     void processAllPending() override;
     [[nodiscard]] bool waitForEvent(Event& outEvent, uint32_t timeoutMs) override;
 
@@ -40,6 +121,20 @@ class FreeRtosEventBus : public IEventBus {
      */
     bool publishFromISR(const Event& event);
 
+    /**
+     * @brief Freeze the subscriber table for lock-free dispatch
+     *
+     * Call once all startup subscriptions are registered (done by
+     * ParkingGarageSystem::initialize()). Subscriptions after sealing are
+     * still allowed but go through a copy-on-write table swap.
+     */
+    void seal();
+
+    /**
+     * @brief Check if subscriber table is sealed
+     */
+    [[nodiscard]] bool isSealed() const;
+
     /**
      * @brief Start the internal event loop task
      *
@@ -49,14 +144,19 @@ class FreeRtosEventBus : public IEventBus {
      * @param stackSize Task stack size in bytes (default: 4096)
      * @param priority Task priority (default: 5)
      * @param taskName Name for the task (default: "event_loop")
+     * @param core Core to pin the task to (default: tskNO_AFFINITY)
      */
     void startEventLoop(uint32_t stackSize = 4096, UBaseType_t priority = 5,
-                        const char* taskName = "event_loop");
+                        const char* taskName = "event_loop", BaseType_t core = tskNO_AFFINITY);
 
     /**
      * @brief Stop the internal event loop task
      *
-     * Stops and deletes the event loop task if running.
+     * Wakes the loop and waits until the task has exited (up to
+     * STOP_TIMEOUT_MS; only a task stuck in a handler is deleted forcibly,
+     * and the table reads it had in progress are dropped).
+     * The idle loop blocks without a timeout, so stopping needs this explicit
+     * wakeup instead of a polled flag.
      */
     void stopEventLoop();
 
@@ -66,13 +166,328 @@ class FreeRtosEventBus : public IEventBus {
      */
     [[nodiscard]] bool isEventLoopRunning() const;
 
+    /**
+     * @brief Maximum number of events drained and dispatched per wakeup
+     */
+    static constexpr size_t EVENT_LOOP_BATCH_SIZE = 8;
+
+    /**
+     * @brief Maximum time stopEventLoop() waits for the task to exit
+     */
+    static constexpr uint32_t STOP_TIMEOUT_MS = 1000;
+
+    /**
+     * @brief Receive queued events and pass them to a compile-time dispatcher
+     *
+     * Same queue path as the event loop - lanes, ISR rings, coalesced levels,
+     * trace and latency - but each event goes to dispatcher(event) instead of
+     * the subscriber table, so the call can be resolved and inlined at compile
+     * time. Used by StaticEventBus. Inline dispatch does not apply: events
+     * published by the dispatcher are queued.
+     *
+     * @param maxCount Maximum number of queue entries to take (up to EVENT_LOOP_BATCH_SIZE)
+     * @param ticks Time to wait for the first entry
+     * @return Number of queue entries taken (a coalesced entry may dispatch 0-2 events)
+     */
+    template <typename Dispatcher>
+    size_t dispatchPendingTo(Dispatcher& dispatcher, size_t maxCount, TickType_t ticks) {
+        PackedEvent batch[EVENT_LOOP_BATCH_SIZE];
+        size_t count = receiveBatch(batch, std::min(maxCount, EVENT_LOOP_BATCH_SIZE), ticks);
+        for (size_t i = 0; i < count; i++) {
+            uint64_t now = esp_timer_get_time();
+            PackedEvent levels[2] = {batch[i]};
+            size_t levelCount = (batch[i].flags & PACKED_EVENT_COALESCED) ? takeLevels(batch[i], levels) : 1;
+            for (size_t k = 0; k < levelCount; k++) {
+                noteDispatched(levels[k], now);
+                dispatcher(unpackEvent(levels[k], now));
+            }
+        }
+        return count;
+    }
+
+    /**
+     * @brief Create an async subscriber worker with its own queue and task
+     *
+     * Subscribe to it with SubscribeOptions{.async = true, .worker = worker}.
+     * The first async subscription without a worker creates a default worker
+     * (AsyncWorkerConfig defaults). Workers start and stop with the event loop.
+     *
+     * @return Worker owned by the bus
+     */
+    AsyncEventWorker* createAsyncWorker(const AsyncWorkerConfig& config);
+
+    /**
+     * @brief Get counters of all async workers, in creation order
+     */
+    [[nodiscard]] std::vector<AsyncWorkerStats> getAsyncWorkerStats() const;
+
+    /**
+     * @brief Dispatch events queued for async workers in the calling task (for synchronous testing)
+     * @return Number of events dispatched
+     */
+    size_t processAsyncPending();
+
+    /**
+     * @brief Get configured capacity of a lane
+     */
+    [[nodiscard]] size_t queueCapacity(EventPriority priority) const;
+
+    /**
+     * @brief Set the overflow policy of every event type
+     *
+     * May be changed while the loop runs; an event already being published
+     * may still use the previous policy. Policies apply to publish() and
+     * publishFromISR(); a batch that does not fit is rejected as a whole.
+     */
+    void setOverflowPolicy(OverflowPolicy policy);
+
+    /**
+     * @brief Set the overflow policy of one event type
+     */
+    void setOverflowPolicy(EventType type, OverflowPolicy policy);
+
+    /**
+     * @brief Get the overflow policy of an event type
+     */
+    [[nodiscard]] OverflowPolicy getOverflowPolicy(EventType type) const;
+
+    /**
+     * @brief Set how long BlockWithTimeout waits for a free slot
+     *
+     * The publisher sleeps until a consumer drains events from the lane.
+     * Publishing from an ISR or from the event loop task itself never blocks
+     * and drops the event instead.
+     */
+    void setBlockTimeout(uint32_t timeoutMs);
+
+    /**
+     * @brief Create an ISR ingestion ring for one GPIO input
+     *
+     * Call during initialization, before the event loop starts. Hand the ring
+     * to EspGpioInput::setIsrEventRing().
+     *
+     * @param lowLevelEvent Event type for an edge to LOW level
+     * @param highLevelEvent Event type for an edge to HIGH level
+     * @param source Event::source (lane) of the input
+     * @return Ring owned by the bus, or nullptr if MAX_ISR_SOURCES are in use
+     */
+    IsrEventRing* createIsrEventRing(EventType lowLevelEvent, EventType highLevelEvent, uint8_t source = 0);
+
+    /**
+     * @brief Maximum number of ISR ingestion rings (button and two light barriers per lane)
+     */
+    static constexpr size_t MAX_ISR_SOURCES = 3 * MAX_EVENT_SOURCES;
+
+    /**
+     * @brief Get the flight recorder of published, dropped and dispatched events
+     */
+    [[nodiscard]] EventTraceRecorder& getTraceRecorder();
+
+    /**
+     * @brief Enable coalescing of level-style events (disabled by default)
+     */
+    void setCoalescing(bool enabled);
+
+    /**
+     * @brief Check if level-style events are coalesced
+     */
+    [[nodiscard]] bool isCoalescing() const;
+
+    /**
+     * @brief Enable inline dispatch of cascading events (disabled by default)
+     *
+     * A publish() from a handler running on the dispatching task then skips
+     * the lane queues: the event goes to a small FIFO that is drained right
+     * after the current event's handlers return, before the next queued
+     * event. The FIFO belongs to one dispatching task at a time (normally the
+     * event loop); a processAllPending() or waitForEvent() running on another
+     * task meanwhile queues its cascades as usual. Cascades keep publish order and cost no queue copy
+     * or task round-trip. When the FIFO is full, events take the normal queue
+     * path; a publishBatch() is inlined only if all of its events fit.
+     * publishFromISR() is never inlined.
+     */
+    void setInlineDispatch(bool enabled);
+
+    /**
+     * @brief Check if cascading events are dispatched inline
+     */
+    [[nodiscard]] bool isInlineDispatch() const;
+
+    /**
+     * @brief Capacity of the inline dispatch FIFO
+     */
+    static constexpr size_t INLINE_FIFO_SIZE = 8;
+
+    /**
+     * @brief Raise the loop task's priority while the queues are backed up
+     *
+     * The backlog is the number of events in both lane queues (parked events
+     * and ISR rings are not counted). lowWater is clamped below highWater.
+     * Only task-context publishes raise the priority; a backlog left by ISRs
+     * is picked up by the loop itself on its next batch. A boost priority not
+     * above the loop's start priority has no effect.
+     */
+    void setPriorityBoost(const PriorityBoostConfig& config);
+
+    /**
+     * @brief Get the current priority boost thresholds
+     */
+    [[nodiscard]] PriorityBoostConfig getPriorityBoost() const;
+
+    /**
+     * @brief Get a snapshot of the per-type and per-lane counters
+     */
+    [[nodiscard]] EventBusStats getStats() const;
+
+    /**
+     * @brief Get publish-to-dispatch latency percentiles of an event type
+     *
+     * Measured from Event::timestamp (the publish time, or the interrupt time
+     * for ISR ring events) to the start of the first handler.
+     */
+    [[nodiscard]] LatencyStats getLatencyStats(EventType type) const;
+
+    /**
+     * @brief Get the raw latency histogram of an event type
+     */
+    [[nodiscard]] const LatencyHistogram& getLatencyHistogram(EventType type) const;
+
+    /**
+     * @brief Get run time statistics of all handlers, in subscription order
+     */
+    [[nodiscard]] std::vector<HandlerStats> getHandlerStats() const;
+
+    /**
+     * @brief Get total number of handler calls that exceeded their budget
+     */
+    [[nodiscard]] uint32_t getBudgetOverruns() const;
+
+    /**
+     * @brief Reset counters, high-watermarks, latency histograms and handler profiles (queued counts are kept)
+     */
+    void resetStats();
+
   private:
+    struct Lane {
+        QueueHandle_t queue = nullptr;
+        size_t size = 0;
+        std::atomic<size_t> reservedSlots{0}; // Queued + being sent
+        std::atomic<size_t> highWatermark{0};
+        SemaphoreHandle_t slotFreed = nullptr;  // Given by consumers while a publisher waits for a slot
+        std::atomic<uint32_t> slotWaiters{0};   // Publishers blocked in waitForSlot()
+    };
+
+    struct TypeCounters {
+        std::atomic<uint32_t> published{0};
+        std::atomic<uint32_t> dropped{0};
+        std::atomic<uint32_t> coalesced{0};
+        std::atomic<uint32_t> inlined{0};
+        std::atomic<uint32_t> queued{0};
+        std::atomic<uint32_t> highWatermark{0};
+    };
+
+    Lane& laneFor(EventType type);
+    static bool reserveSlots(Lane& lane, size_t count);
+    static void releaseSlots(Lane& lane, size_t count);
+    struct LevelCell {
+        PackedEvent last;     // Latest level merged into the queued event
+        bool pending = false; // Event of this source is queued
+        bool hasLast = false;
+    };
+
+    bool enqueue(const PackedEvent& event, BaseType_t* isrTaskWoken);
+    bool enqueueToLane(const PackedEvent& packed, BaseType_t* isrTaskWoken);
+    LevelCell* levelCell(const PackedEvent& packed);
+    bool mergeLevel(LevelCell& cell, const PackedEvent& packed);
+    void cancelLevel(LevelCell& cell, bool fromISR);
+    size_t takeLevels(const PackedEvent& token, PackedEvent* levels);
+    bool sendToLane(Lane& lane, const PackedEvent& packed);
+    void enqueueReserved(Lane& lane, const PackedEvent& packed);
+    bool evictOldest(Lane& lane, BaseType_t* isrTaskWoken);
+    bool waitForSlot(Lane& lane);
+    void notifySlotsFreed(Lane& lane);
+    void park(const PackedEvent& packed);
+    size_t takeParked(EventPriority priority, PackedEvent* batch, size_t maxCount);
+    void notePublished(const PackedEvent& packed);
+    void noteQueued(uint8_t type);
+    void noteDropped(const PackedEvent& packed, bool fromISR);
+    void noteDispatched(const PackedEvent& packed, uint64_t now);
+    size_t drainIsrRings(PackedEvent* batch, size_t maxCount);
+    size_t takeAvailable(PackedEvent* batch, size_t maxCount);
+    size_t receiveBatch(PackedEvent* batch, size_t maxCount, TickType_t ticks);
+    void dispatchBatch(const PackedEvent* batch, size_t count);
+    void dispatchPacked(const EventDispatchTable& table, const PackedEvent& packed);
     void dispatchEvent(const Event& event);
+    void dispatchToTable(const EventDispatchTable& table, const Event& event);
+    bool canPublishInline(size_t count) const;
+    bool publishInline(const PackedEvent& packed);
+    void drainInline(const EventDispatchTable* table);
+    bool beginDispatch();
+    void endDispatch(bool inlineOwner);
+    bool ownsInlineFifo() const;
+    void addToTable(EventType type, EventHandler handler, HandlerProfile* profile, const char* name,
+                    PayloadFilter filter = {}, uint8_t source = EVENT_SOURCE_ANY);
+    EventDispatchTable* beginTableUpdate();
+    void commitTableUpdate(EventDispatchTable* table);
+    std::atomic<uint32_t>& tableReaders();
+    const EventDispatchTable* acquireTable(std::atomic<uint32_t>& readers);
+    void releaseTable(std::atomic<uint32_t>& readers);
+    AsyncEventWorker* createAsyncWorkerLocked(const AsyncWorkerConfig& config);
+    static bool acceptsSource(const SubscribeOptions& options);
+    static EventHandler asyncForwarder(AsyncEventWorker* worker);
+    void startLoopTask(TaskFunction_t task, void* context, uint32_t stackSize, UBaseType_t priority,
+                       const char* taskName, BaseType_t core);
+    bool loopStopRequested() const;
+    void signalLoopExited();
+    size_t queuedEvents() const;
+    void updatePriorityBoost(TickType_t lockTicks);
+    void endPriorityBoost();
     static void eventLoopTask(void* pvParameters);
 
-    QueueHandle_t m_queue;
+    // Runs its own loop task on this bus's queues
+    template <typename... Subscribers>
+    friend class StaticEventBus;
+
+    std::array<Lane, EVENT_PRIORITY_COUNT> m_lanes; // Indexed by EventPriority
+    SemaphoreHandle_t m_wakeup;                      // Given after every send
+    std::array<std::atomic<OverflowPolicy>, EVENT_TYPE_COUNT> m_overflowPolicies{}; // Changed at runtime by the console
+    std::atomic<TickType_t> m_blockTicks{pdMS_TO_TICKS(10)};
+    std::array<TypeCounters, EVENT_TYPE_COUNT> m_typeCounters;
+    std::array<PackedEvent, EVENT_TYPE_COUNT> m_parked{}; // OverwriteLatest events waiting for room
+    std::atomic<uint32_t> m_parkedMask{0};                 // Bit per type, written under m_parkedLock
+    portMUX_TYPE m_parkedLock = portMUX_INITIALIZER_UNLOCKED;
+    std::array<LevelCell, LEVEL_SOURCE_COUNT * MAX_EVENT_SOURCES> m_levelCells{}; // See levelCell()
+    portMUX_TYPE m_levelLock = portMUX_INITIALIZER_UNLOCKED;
+    bool m_coalescing = false;
+    bool m_inlineDispatch = false;
+    std::atomic<TaskHandle_t> m_inlineOwner{nullptr};         // Dispatching task that owns the inline FIFO
+    std::array<PackedEvent, INLINE_FIFO_SIZE> m_inlineFifo{}; // Accessed by m_inlineOwner only
+    size_t m_inlineHead = 0;
+    size_t m_inlineCount = 0;
+    std::array<std::unique_ptr<IsrEventRing>, MAX_ISR_SOURCES> m_isrRings;
+    std::atomic<size_t> m_isrRingCount{0};
+    EventTraceRecorder m_trace;
+    std::array<LatencyHistogram, EVENT_TYPE_COUNT> m_latency;
     SemaphoreHandle_t m_mutex;
-    std::map<EventType, std::vector<std::function<void(const Event&)>>> m_subscribers;
+    std::atomic<EventDispatchTable*> m_subscribers;
+    std::atomic<uint32_t> m_tableReaders{0}; // Dispatches using a table (see acquireTable())
+    std::atomic<uint32_t> m_loopReaders{0};  // Same, made by the event loop task
+    std::vector<std::unique_ptr<EventDispatchTable>> m_tables; // Active table is last
+    std::vector<std::unique_ptr<HandlerProfile>> m_profiles;   // Stable addresses, shared by all tables
+    std::atomic<uint32_t> m_budgetOverruns{0};
+    std::vector<std::unique_ptr<AsyncEventWorker>> m_workers; // Destroyed before the profiles they reference
+    AsyncEventWorker* m_defaultWorker = nullptr;
+    std::atomic<bool> m_sealed{false};
     TaskHandle_t m_eventLoopTask = nullptr;
-    volatile bool m_stopRequested = false;
+    SemaphoreHandle_t m_loopExited; // Given by the event loop task right before it exits
+    std::atomic<bool> m_stopRequested{false};
+    UBaseType_t m_loopPriority = 0; // Start priority of the loop task
+    std::atomic<size_t> m_boostHighWater{0};
+    std::atomic<size_t> m_boostLowWater{0};
+    std::atomic<UBaseType_t> m_boostPriority{10};
+    SemaphoreHandle_t m_boostLock; // Serializes priority changes
+    std::atomic<bool> m_boosted{false};
+    std::atomic<uint64_t> m_boostStartUs{0};
+    std::atomic<uint64_t> m_boostedUs{0}; // Completed boosts only
+    std::atomic<uint32_t> m_boostCount{0};
 };
@@ -0,0 +1,104 @@
+#pragma once
+
+#include "Event.h"
+#include "PayloadFilter.h"
+#include <atomic>
+#include <cstdint>
+
+class AsyncEventWorker;
+
+/**
+ * @brief Optional settings of a subscription
+ */
+struct SubscribeOptions {
+    const char* name = nullptr;         // Shown in handler statistics; must outlive the bus (string literal)
+    uint32_t budgetUs = 0;              // Run time budget per call, 0 = unlimited
+    bool async = false;                 // Run on an async worker task instead of the event loop
+    AsyncEventWorker* worker = nullptr; // Worker for async handlers, nullptr = the bus default worker
+    PayloadFilter filter{};             // Call the handler only for matching payloads (subscribe() only)
+    uint8_t source = EVENT_SOURCE_ANY;  // Receive events of this lane only (Event::source)
+};
+
+/**
+ * @brief Snapshot of one handler's run time statistics
+ */
+struct HandlerStats {
+    EventType type = EventType::EntryButtonPressed; // Valid if categories == 0
+    EventCategoryMask categories = 0;               // Categories of a subscribeCategory() handler
+    uint8_t source = EVENT_SOURCE_ANY;              // Lane the handler is routed to
+    const char* name = nullptr;
+    uint32_t budgetUs = 0;
+    uint32_t calls = 0;
+    uint32_t avgUs = 0;
+    uint32_t maxUs = 0;
+    uint32_t overruns = 0; // Calls that exceeded budgetUs
+};
+
+/**
+ * @brief Run time counters of one subscription
+ *
+ * Owned by the event bus at a stable address and referenced from every
+ * dispatch table generation, so copy-on-write table swaps keep the counters.
+ * Updated by the dispatching task only; read from any task.
+ */
+struct HandlerProfile {
+    EventType type;
+    EventCategoryMask categories = 0; // Non-zero for category subscriptions
+    SubscribeOptions options;
+    std::atomic<uint32_t> calls{0};
+    std::atomic<uint64_t> totalUs{0};
+    std::atomic<uint32_t> maxUs{0};
+    std::atomic<uint32_t> overruns{0};
+
+    HandlerProfile(EventType t, const SubscribeOptions& o)
+        : type(t)
+        , options(o) {}
+
+    HandlerProfile(EventCategoryMask c, const SubscribeOptions& o)
+        : type(EventType::EntryButtonPressed)
+        , categories(c)
+        , options(o) {}
+
+    /**
+     * @brief Account one call
+     * @return true if the call exceeded the budget
+     */
+    bool record(uint32_t elapsedUs) {
+        calls.fetch_add(1, std::memory_order_relaxed);
+        totalUs.fetch_add(elapsedUs, std::memory_order_relaxed);
+        if (elapsedUs > maxUs.load(std::memory_order_relaxed)) {
+            maxUs.store(elapsedUs, std::memory_order_relaxed);
+        }
+        if (options.budgetUs != 0 && elapsedUs > options.budgetUs) {
+            overruns.fetch_add(1, std::memory_order_relaxed);
+            return true;
+        }
+        return false;
+    }
+
+    /**
+     * @brief Get a snapshot of the counters
+     */
+    [[nodiscard]] HandlerStats getStats() const {
+        HandlerStats stats;
+        stats.type = type;
+        stats.categories = categories;
+        stats.source = options.source;
+        stats.name = options.name;
+        stats.budgetUs = options.budgetUs;
+        stats.calls = calls.load(std::memory_order_relaxed);
+        stats.maxUs = maxUs.load(std::memory_order_relaxed);
+        stats.overruns = overruns.load(std::memory_order_relaxed);
+        if (stats.calls != 0) {
+            stats.avgUs = static_cast<uint32_t>(totalUs.load(std::memory_order_relaxed) / stats.calls);
+        }
+        return stats;
+    }
+
+    void reset() {
+        calls.store(0, std::memory_order_relaxed);
+        totalUs.store(0, std::memory_order_relaxed);
+        maxUs.store(0, std::memory_order_relaxed);
+        overruns.store(0, std::memory_order_relaxed);
+    }
+};
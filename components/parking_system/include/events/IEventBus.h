@@ -1,7 +1,17 @@
 #pragma once
 
 #include "Event.h"
-#include <functional>
+#include "EventHandler.h"
+#include "HandlerProfile.h"
+#include <span>
+
+/**
+ * @brief How a component attaches its handlers to the event bus
+ */
+enum class SubscriptionMode : uint8_t {
+    Runtime, // Subscribe handlers on the IEventBus (FreeRtosEventBus, mocks)
+    Static   // Listed in StaticEventBus<...>, called through handle(EventTag<T>, event) overloads
+};
 
 /**
  * @brief Interface for event bus
@@ -18,7 +28,31 @@ class IEventBus {
      * @param type Event type to subscribe to
      * @param handler Callback function called when event occurs
      */
-    virtual void subscribe(EventType type, std::function<void(const Event&)> handler) = 0;
+    virtual void subscribe(EventType type, EventHandler handler) = 0;
+
+    /**
+     * @brief Subscribe with a name and run time budget for profiling
+     * @param type Event type to subscribe to
+     * @param handler Callback function called when event occurs
+     * @param options Handler name and budget
+     */
+    virtual void subscribe(EventType type, EventHandler handler, const SubscribeOptions& options) = 0;
+
+    /**
+     * @brief Subscribe to all event types of one or more categories
+     *
+     * Category handlers run after the handlers subscribed to the event type.
+     *
+     * @param categories Mask of EVENT_CATEGORY_* bits (see eventCategory())
+     * @param handler Callback function called when a matching event occurs
+     */
+    virtual void subscribeCategory(EventCategoryMask categories, EventHandler handler) = 0;
+
+    /**
+     * @brief Subscribe to event categories with a name and run time budget
+     */
+    virtual void subscribeCategory(EventCategoryMask categories, EventHandler handler,
+                                   const SubscribeOptions& options) = 0;
 
     /**
      * @brief Publish event to all subscribers
@@ -26,6 +60,19 @@ class IEventBus {
      */
     virtual void publish(const Event& event) = 0;
 
+    /**
+     * @brief Publish several events as one unit
+     *
+     * Either all events are queued, in order, or none of them is. Level
+     * coalescing applies per event as in publish(); overflow policies do not:
+     * a batch that does not fit is dropped whole, each event counted as
+     * dropped, whatever the policy of its type.
+     *
+     * @param events Events to publish
+     * @return true if all events were queued
+     */
+    virtual bool publishBatch(std::span<const Event> events) = 0;
+
     /**
      * @brief Process all pending events (for synchronous testing)
      */
@@ -0,0 +1,182 @@
+#pragma once
+
+#include <concepts>
+#include <cstddef>
+#include <cstring>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+template <typename Signature, size_t Capacity>
+class InlineDelegate;
+
+/**
+ * @brief Fixed-capacity, non-allocating callable wrapper
+ *
+ * Drop-in replacement for std::function for small callables such as lambdas
+ * capturing `this`. The callable is stored in an inline buffer of @p Capacity
+ * bytes; a callable that does not fit is rejected at compile time, so
+ * construction never touches the heap.
+ *
+ * Trivially copyable callables (the common case) are copied with memcpy and
+ * need no destructor call. Other callables go through a small manager
+ * function for copy/move/destroy.
+ *
+ * @tparam R Return type
+ * @tparam Args Argument types
+ * @tparam Capacity Inline storage size in bytes
+ */
+template <typename R, typename... Args, size_t Capacity>
+class InlineDelegate<R(Args...), Capacity> {
+  public:
+    InlineDelegate() = default;
+    InlineDelegate(std::nullptr_t) {}
+
+    /**
+     * @brief Storage alignment (enough for pointers, integers and doubles)
+     */
+    static constexpr size_t ALIGNMENT = alignof(double) > alignof(void*) ? alignof(double) : alignof(void*);
+
+    template <typename F>
+        requires(!std::same_as<std::remove_cvref_t<F>, InlineDelegate> &&
+                 std::is_invocable_r_v<R, std::decay_t<F>&, Args...>)
+    InlineDelegate(F&& callable) { // NOLINT(google-explicit-constructor)
+        using Fn = std::decay_t<F>;
+        static_assert(sizeof(Fn) <= Capacity,
+                      "Callable too large for InlineDelegate - capture less or raise capacity");
+        static_assert(alignof(Fn) <= ALIGNMENT,
+                      "Callable over-aligned for InlineDelegate storage");
+        static_assert(std::is_nothrow_move_constructible_v<Fn>,
+                      "InlineDelegate callables must be nothrow move constructible");
+
+        ::new (static_cast<void*>(m_storage)) Fn(std::forward<F>(callable));
+        m_ops = &OPS<Fn>;
+    }
+
+    InlineDelegate(const InlineDelegate& other) {
+        copyFrom(other);
+    }
+
+    InlineDelegate(InlineDelegate&& other) noexcept {
+        moveFrom(other);
+    }
+
+    InlineDelegate& operator=(const InlineDelegate& other) {
+        if (this != &other) {
+            reset();
+            copyFrom(other);
+        }
+        return *this;
+    }
+
+    InlineDelegate& operator=(InlineDelegate&& other) noexcept {
+        if (this != &other) {
+            reset();
+            moveFrom(other);
+        }
+        return *this;
+    }
+
+    InlineDelegate& operator=(std::nullptr_t) {
+        reset();
+        return *this;
+    }
+
+    ~InlineDelegate() {
+        reset();
+    }
+
+    /**
+     * @brief Invoke the stored callable (must not be empty)
+     */
+    R operator()(Args... args) const {
+        return m_ops->invoke(m_storage, std::forward<Args>(args)...);
+    }
+
+    /**
+     * @brief Check if a callable is stored
+     */
+    explicit operator bool() const {
+        return m_ops != nullptr;
+    }
+
+    /**
+     * @brief Inline storage size in bytes
+     */
+    static constexpr size_t capacity() {
+        return Capacity;
+    }
+
+  private:
+    enum class Op {
+        Copy,
+        Move,
+        Destroy
+    };
+
+    struct Ops {
+        R (*invoke)(void* storage, Args... args);
+        void (*manage)(Op op, void* dst, void* src); // nullptr = trivially copyable
+    };
+
+    template <typename Fn>
+    static R invokeImpl(void* storage, Args... args) {
+        return (*static_cast<Fn*>(storage))(std::forward<Args>(args)...);
+    }
+
+    template <typename Fn>
+    static void manageImpl(Op op, void* dst, void* src) {
+        switch (op) {
+            case Op::Copy:
+                ::new (dst) Fn(*static_cast<const Fn*>(src));
+                break;
+            case Op::Move:
+                ::new (dst) Fn(std::move(*static_cast<Fn*>(src)));
+                static_cast<Fn*>(src)->~Fn();
+                break;
+            case Op::Destroy:
+                static_cast<Fn*>(dst)->~Fn();
+                break;
+        }
+    }
+
+    template <typename Fn>
+    static constexpr Ops OPS = {
+        &invokeImpl<Fn>,
+        (std::is_trivially_copyable_v<Fn> && std::is_trivially_destructible_v<Fn>) ? nullptr : &manageImpl<Fn>};
+
+    void copyFrom(const InlineDelegate& other) {
+        if (other.m_ops == nullptr) {
+            return;
+        }
+        if (other.m_ops->manage == nullptr) {
+            std::memcpy(m_storage, other.m_storage, Capacity);
+        } else {
+            other.m_ops->manage(Op::Copy, m_storage, other.m_storage);
+        }
+        m_ops = other.m_ops;
+    }
+
+    void moveFrom(InlineDelegate& other) {
+        if (other.m_ops == nullptr) {
+            return;
+        }
+        if (other.m_ops->manage == nullptr) {
+            std::memcpy(m_storage, other.m_storage, Capacity);
+        } else {
+            other.m_ops->manage(Op::Move, m_storage, other.m_storage);
+        }
+        m_ops = other.m_ops;
+        other.m_ops = nullptr;
+    }
+
+    void reset() {
+        if (m_ops != nullptr && m_ops->manage != nullptr) {
+            m_ops->manage(Op::Destroy, m_storage, nullptr);
+        }
+        m_ops = nullptr;
+    }
+
+    alignas(ALIGNMENT) mutable unsigned char m_storage[Capacity] = {};
+    const Ops* m_ops = nullptr;
+};
@@ -0,0 +1,98 @@
+#pragma once
+
+#include "Event.h"
+#include "PackedEvent.h"
+#include "freertos/FreeRTOS.h"
+#include "freertos/semphr.h"
+#include <array>
+#include <atomic>
+
+/**
+ * @brief Lock-free single-producer/single-consumer ring of GPIO edges
+ *
+ * Ingestion path from one GPIO interrupt to the event loop that does not
+ * allocate, lock or touch the event queues: the ISR stores the level and the
+ * edge timestamp it captured, then signals the bus wakeup semaphore. The
+ * event loop pops edges as PackedEvents whose timestamp is the interrupt time,
+ * so edge-to-dispatch latency is measurable from Event::timestamp.
+ *
+ * Rings are created and owned by FreeRtosEventBus (internal RAM), and the
+ * producer side is IRAM-safe. Exactly one ISR may push and one task may pop.
+ */
+class IsrEventRing {
+  public:
+    /**
+     * @brief Number of edges the ring can hold (power of two)
+     */
+    static constexpr uint32_t CAPACITY = 16;
+
+    /**
+     * @brief Construct ring for one input
+     * @param lowLevelEvent Event type for an edge to LOW level
+     * @param highLevelEvent Event type for an edge to HIGH level
+     * @param wakeup Semaphore given after every push
+     * @param source Event::source of the popped events (lane of the input)
+     */
+    IsrEventRing(EventType lowLevelEvent, EventType highLevelEvent, SemaphoreHandle_t wakeup, uint8_t source = 0);
+
+    // Prevent copying
+    IsrEventRing(const IsrEventRing&) = delete;
+    IsrEventRing& operator=(const IsrEventRing&) = delete;
+
+    /**
+     * @brief Store an edge from ISR context
+     * @param level Input level after the edge
+     * @param timestamp Low 32 bits of esp_timer_get_time() at the interrupt (us)
+     * @return false if the ring is full (edge counted as dropped)
+     */
+    bool pushFromISR(bool level, uint32_t timestamp);
+
+    /**
+     * @brief Store an edge from task context (simulated interrupts)
+     */
+    bool push(bool level, uint32_t timestamp);
+
+    /**
+     * @brief Take the oldest edge (consumer only)
+     * @return false if the ring is empty
+     */
+    bool pop(PackedEvent& outEvent);
+
+    /**
+     * @brief Take and clear the number of dropped edges for a level
+     */
+    uint32_t takeDropped(bool level);
+
+    /**
+     * @brief Get event type published for a level
+     */
+    [[nodiscard]] EventType eventFor(bool level) const {
+        return level ? m_highLevelEvent : m_lowLevelEvent;
+    }
+
+    /**
+     * @brief Get Event::source of the popped events
+     */
+    [[nodiscard]] uint8_t source() const {
+        return m_source;
+    }
+
+  private:
+    struct Edge {
+        uint32_t timestamp;
+        bool level;
+    };
+
+    bool write(bool level, uint32_t timestamp);
+
+    std::array<Edge, CAPACITY> m_edges{};
+    std::atomic<uint32_t> m_head{0}; // Written by the producer only
+    std::atomic<uint32_t> m_tail{0}; // Written by the consumer only
+    std::array<std::atomic<uint32_t>, 2> m_dropped{}; // Indexed by level
+    EventType m_lowLevelEvent;
+    EventType m_highLevelEvent;
+    SemaphoreHandle_t m_wakeup;
+    uint8_t m_source;
+};
+
+static_assert((IsrEventRing::CAPACITY & (IsrEventRing::CAPACITY - 1)) == 0, "Ring capacity must be a power of two");
@@ -0,0 +1,109 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+
+/**
+ * @brief Percentiles of one latency histogram (microseconds)
+ *
+ * Percentiles are upper bounds of log2 buckets, so they overstate the real
+ * value by less than a factor of two; max is exact.
+ */
+struct LatencyStats {
+    uint32_t count = 0;
+    uint32_t p50 = 0;
+    uint32_t p95 = 0;
+    uint32_t p99 = 0;
+    uint32_t max = 0;
+};
+
+/**
+ * @brief Lock-free log2-bucketed latency histogram
+ *
+ * Bucket 0 counts 0 us, bucket i counts [2^(i-1), 2^i) us; the last bucket
+ * also takes everything longer (>= 4 s). Recording is a bit_width() and two
+ * relaxed atomic updates, cheap enough for every dispatched event.
+ */
+class LatencyHistogram {
+  public:
+    /**
+     * @brief Number of buckets
+     */
+    static constexpr size_t BUCKET_COUNT = 24;
+
+    /**
+     * @brief Record one latency sample
+     */
+    void record(uint32_t latencyUs) {
+        size_t bucket = static_cast<size_t>(std::bit_width(latencyUs));
+        if (bucket >= BUCKET_COUNT) {
+            bucket = BUCKET_COUNT - 1;
+        }
+        m_buckets[bucket].fetch_add(1, std::memory_order_relaxed);
+
+        uint32_t max = m_max.load(std::memory_order_relaxed);
+        while (latencyUs > max && !m_max.compare_exchange_weak(max, latencyUs, std::memory_order_relaxed)) {
+        }
+    }
+
+    /**
+     * @brief Get sample count and p50/p95/p99/max
+     */
+    [[nodiscard]] LatencyStats getStats() const {
+        std::array<uint32_t, BUCKET_COUNT> counts;
+        LatencyStats stats;
+        for (size_t i = 0; i < BUCKET_COUNT; i++) {
+            counts[i] = m_buckets[i].load(std::memory_order_relaxed);
+            stats.count += counts[i];
+        }
+        stats.max = m_max.load(std::memory_order_relaxed);
+        stats.p50 = percentile(counts, stats.count, 50, stats.max);
+        stats.p95 = percentile(counts, stats.count, 95, stats.max);
+        stats.p99 = percentile(counts, stats.count, 99, stats.max);
+        return stats;
+    }
+
+    /**
+     * @brief Get number of samples in a bucket
+     */
+    [[nodiscard]] uint32_t bucketCount(size_t bucket) const {
+        return m_buckets[bucket].load(std::memory_order_relaxed);
+    }
+
+    /**
+     * @brief Forget all samples
+     */
+    void reset() {
+        for (auto& bucket : m_buckets) {
+            bucket.store(0, std::memory_order_relaxed);
+        }
+        m_max.store(0, std::memory_order_relaxed);
+    }
+
+  private:
+    static uint32_t percentile(const std::array<uint32_t, BUCKET_COUNT>& counts, uint32_t total, uint32_t percent,
+                               uint32_t max) {
+        if (total == 0) {
+            return 0;
+        }
+
+        // Rank of the sample at the percentile (1-based, rounded up)
+        uint64_t rank = (static_cast<uint64_t>(total) * percent + 99) / 100;
+        uint64_t seen = 0;
+        for (size_t i = 0; i < BUCKET_COUNT; i++) {
+            seen += counts[i];
+            if (seen >= rank) {
+                // Upper bound of the bucket, never above the observed maximum
+                uint32_t upper = (i == 0) ? 0 : ((i < 32) ? (1u << i) - 1 : UINT32_MAX);
+                return (i == BUCKET_COUNT - 1 || upper > max) ? max : upper;
+            }
+        }
+        return max;
+    }
+
+    std::array<std::atomic<uint32_t>, BUCKET_COUNT> m_buckets{};
+    std::atomic<uint32_t> m_max{0};
+};
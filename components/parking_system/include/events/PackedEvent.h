@@ -0,0 +1,114 @@
+#pragma once
+
+#include "Event.h"
+#include <type_traits>
+#include <utility>
+
+/**
+ * @brief Compact wire format of an Event for the FreeRTOS queue (12 bytes)
+ *
+ * The bus converts Event <-> PackedEvent at the queue boundary, so every
+ * xQueueSend/xQueueReceive copies 12 bytes instead of a full Event with its
+ * 64-bit timestamp, variant discriminator and padding.
+ *
+ * The timestamp keeps only the low 32 bits of the microsecond clock. It is
+ * rebuilt relative to a reference time when unpacking, which is exact as long
+ * as the event is less than ~35 minutes away from the reference.
+ *
+ * A queued PackedEvent with a pooled payload owns one reference to its block:
+ * take it with retainPayload() when the item is queued, and end it exactly
+ * once - unpackEvent() hands it to the Event, releasePayload() drops it.
+ */
+struct PackedEvent {
+    uint8_t type;       // EventType
+    uint8_t payloadTag; // PayloadTag
+    uint8_t flags;      // PACKED_EVENT_* bits, 0 for plain events
+    uint8_t source;     // Event::source
+    uint32_t payload;   // uint32_t value, or 0/1 for bool
+    uint32_t timestamp; // Low 32 bits of Event::timestamp (us)
+};
+
+/**
+ * @brief PackedEvent::flags bit: queued token of a coalesced level source
+ *
+ * The event carries the first level of the run; later levels are merged into
+ * the bus's level cell instead of taking queue slots.
+ */
+inline constexpr uint8_t PACKED_EVENT_COALESCED = 0x01;
+
+static_assert(sizeof(PackedEvent) == 12, "PackedEvent must stay 12 bytes");
+static_assert(alignof(PackedEvent) == 4, "PackedEvent must be 4-byte aligned");
+static_assert(std::is_trivially_copyable_v<PackedEvent>, "PackedEvent is copied with memcpy by the queue");
+static_assert(EVENT_TYPE_COUNT <= 256, "EventType must fit in 8 bits");
+static_assert(std::variant_size_v<EventPayload> == 4, "Update PayloadTag when EventPayload changes");
+
+/**
+ * @brief Convert an Event to its queue representation
+ *
+ * Copies a pooled payload's handle without counting a reference; see
+ * retainPayload().
+ */
+inline PackedEvent packEvent(const Event& event) {
+    PackedEvent packed{};
+    packed.type = static_cast<uint8_t>(event.type);
+    packed.payloadTag = static_cast<uint8_t>(event.payload.index());
+    if (const auto* value = std::get_if<uint32_t>(&event.payload)) {
+        packed.payload = *value;
+    } else if (const auto* flag = std::get_if<bool>(&event.payload)) {
+        packed.payload = *flag ? 1 : 0;
+    } else if (const auto* ref = std::get_if<PayloadRef>(&event.payload)) {
+        packed.payload = ref->handle();
+    }
+    packed.timestamp = static_cast<uint32_t>(event.timestamp);
+    packed.source = event.source;
+    return packed;
+}
+
+/**
+ * @brief Count the queue item's reference to its pooled payload (ISR-safe)
+ */
+inline void retainPayload(const PackedEvent& packed) {
+    if (packed.payloadTag == static_cast<uint8_t>(PayloadTag::Pooled)) {
+        PayloadRef::retain(packed.payload);
+    }
+}
+
+/**
+ * @brief Drop the queue item's reference to its pooled payload (ISR-safe)
+ */
+inline void releasePayload(const PackedEvent& packed) {
+    if (packed.payloadTag == static_cast<uint8_t>(PayloadTag::Pooled)) {
+        PayloadRef::release(packed.payload);
+    }
+}
+
+/**
+ * @brief Rebuild an Event from its queue representation
+ *
+ * A pooled payload's reference moves from the queue item to the Event, so
+ * unpack each queued item once.
+ * @param packed Packed event
+ * @param referenceTime Current time (us) used to restore the upper timestamp bits
+ */
+inline Event unpackEvent(const PackedEvent& packed, uint64_t referenceTime) {
+    EventPayload payload;
+    switch (static_cast<PayloadTag>(packed.payloadTag)) {
+        case PayloadTag::UInt32:
+            payload = packed.payload;
+            break;
+        case PayloadTag::Bool:
+            payload = packed.payload != 0;
+            break;
+        case PayloadTag::Pooled:
+            payload = PayloadRef::adopt(packed.payload);
+            break;
+        default:
+            break;
+    }
+
+    // Signed distance to the reference handles 32-bit wrap-around in both directions
+    auto delta = static_cast<int32_t>(packed.timestamp - static_cast<uint32_t>(referenceTime));
+    uint64_t timestamp = referenceTime + static_cast<int64_t>(delta);
+
+    return Event(static_cast<EventType>(packed.type), timestamp, std::move(payload), packed.source);
+}
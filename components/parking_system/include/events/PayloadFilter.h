@@ -0,0 +1,74 @@
+#pragma once
+
+#include "Event.h"
+#include <cstdint>
+#include <variant>
+
+/**
+ * @brief Declarative filter on an event's integer payload
+ *
+ * Evaluated by the event bus before a handler is called, so subscribers that
+ * only care about one ticket ID or a range of values are never invoked for
+ * other events. Applies to uint32_t payloads and to bool payloads as 0/1; an
+ * event without payload never matches an active filter.
+ */
+struct PayloadFilter {
+    enum class Kind : uint8_t {
+        None,  // Match every event
+        Equal, // payload == first
+        Range, // first <= payload <= second
+        Mask   // (payload & first) != 0
+    };
+
+    Kind kind = Kind::None;
+    uint32_t first = 0;
+    uint32_t second = 0;
+
+    static constexpr PayloadFilter equal(uint32_t value) {
+        return PayloadFilter{Kind::Equal, value, 0};
+    }
+
+    static constexpr PayloadFilter range(uint32_t low, uint32_t high) {
+        return PayloadFilter{Kind::Range, low, high};
+    }
+
+    static constexpr PayloadFilter mask(uint32_t bits) {
+        return PayloadFilter{Kind::Mask, bits, 0};
+    }
+
+    [[nodiscard]] constexpr bool isActive() const {
+        return kind != Kind::None;
+    }
+
+    /**
+     * @brief Check a payload value (kind must not be None)
+     */
+    [[nodiscard]] constexpr bool matches(uint32_t value) const {
+        switch (kind) {
+            case Kind::Equal:
+                return value == first;
+            case Kind::Range:
+                return value >= first && value <= second;
+            case Kind::Mask:
+                return (value & first) != 0;
+            default:
+                return true;
+        }
+    }
+};
+
+/**
+ * @brief Get the value payload filters compare against
+ * @return false if the event has no integer or bool payload
+ */
+inline bool filterValue(const EventPayload& payload, uint32_t& outValue) {
+    if (const auto* value = std::get_if<uint32_t>(&payload)) {
+        outValue = *value;
+        return true;
+    }
+    if (const auto* flag = std::get_if<bool>(&payload)) {
+        outValue = *flag ? 1 : 0;
+        return true;
+    }
+    return false;
+}
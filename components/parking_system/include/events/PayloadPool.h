@@ -0,0 +1,211 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <type_traits>
+
+/**
+ * @brief Reference-counted handle to a block in a PayloadPool (4 bytes)
+ *
+ * Carries payloads that do not fit into EventPayload's scalar alternatives -
+ * license plates, fees with currency, raw reader frames - as one 32-bit word,
+ * so events and queue items stay compact. Copies share the block; the block
+ * returns to its pool when the last copy is destroyed. Copying and destroying
+ * are lock-free and ISR-safe.
+ *
+ * Handle layout: pool id (8 bits, 0 = empty handle), block generation (8 bits),
+ * block index (16 bits). The generation makes data() of a stale handle return
+ * nullptr instead of another payload's bytes.
+ */
+class PayloadRef {
+  public:
+    /** @brief Handle value of an empty reference */
+    static constexpr uint32_t INVALID = 0;
+
+    PayloadRef() = default;
+
+    PayloadRef(const PayloadRef& other)
+        : m_handle(other.m_handle) {
+        retain(m_handle);
+    }
+
+    PayloadRef(PayloadRef&& other) noexcept
+        : m_handle(other.m_handle) {
+        other.m_handle = INVALID;
+    }
+
+    PayloadRef& operator=(const PayloadRef& other) {
+        retain(other.m_handle);
+        release(m_handle);
+        m_handle = other.m_handle;
+        return *this;
+    }
+
+    PayloadRef& operator=(PayloadRef&& other) noexcept {
+        if (this != &other) {
+            release(m_handle);
+            m_handle = other.m_handle;
+            other.m_handle = INVALID;
+        }
+        return *this;
+    }
+
+    ~PayloadRef() {
+        release(m_handle);
+    }
+
+    [[nodiscard]] explicit operator bool() const {
+        return m_handle != INVALID;
+    }
+
+    /**
+     * @brief Same block (not same content)
+     */
+    bool operator==(const PayloadRef& other) const {
+        return m_handle == other.m_handle;
+    }
+
+    /**
+     * @brief Payload bytes (nullptr for an empty or stale handle)
+     */
+    [[nodiscard]] const void* data() const;
+
+    /**
+     * @brief Number of payload bytes stored in the block
+     */
+    [[nodiscard]] size_t size() const;
+
+    /**
+     * @brief View the payload as T
+     * @return nullptr unless the payload was created from a T (same size)
+     */
+    template <typename T>
+    [[nodiscard]] const T* as() const {
+        static_assert(std::is_trivially_copyable_v<T>, "Pooled payloads are copied bytewise");
+        static_assert(alignof(T) <= alignof(uint64_t), "Pool blocks are 8-byte aligned");
+        return size() == sizeof(T) ? static_cast<const T*>(data()) : nullptr;
+    }
+
+    /**
+     * @brief Raw handle (PackedEvent::payload of a pooled event)
+     */
+    [[nodiscard]] uint32_t handle() const {
+        return m_handle;
+    }
+
+    /**
+     * @brief Take over a reference already counted for handle (queue boundary)
+     */
+    static PayloadRef adopt(uint32_t handle) {
+        return PayloadRef(handle);
+    }
+
+    /**
+     * @brief Add a reference to a raw handle (ISR-safe, no-op for INVALID)
+     */
+    static void retain(uint32_t handle);
+
+    /**
+     * @brief Drop a reference to a raw handle; the last one frees the block (ISR-safe)
+     */
+    static void release(uint32_t handle);
+
+  private:
+    explicit PayloadRef(uint32_t handle)
+        : m_handle(handle) {}
+
+    uint32_t m_handle = INVALID;
+};
+
+/**
+ * @brief PayloadPool usage counters
+ */
+struct PayloadPoolStats {
+    size_t blockSize = 0;       // Usable bytes per block
+    size_t blockCount = 0;      // Blocks in the pool
+    uint32_t inUse = 0;         // Blocks currently referenced
+    uint32_t highWatermark = 0; // Most blocks referenced at once
+    uint32_t failed = 0;        // Allocations refused (pool empty or payload too large)
+};
+
+/**
+ * @brief Fixed-block pool for out-of-line event payloads
+ *
+ * All memory is allocated once in the constructor (call it during system
+ * setup). allocate() copies the payload into a free block and returns a
+ * PayloadRef holding the first reference; the free list is a lock-free
+ * tagged stack, so producers in tasks and ISRs allocate without locks or
+ * heap use. Publish the reference in an Event; the bus and every async
+ * subscriber queue keep their own references, and the block is freed when
+ * the last handler holding one finishes.
+ *
+ * Up to MAX_POOLS pools may exist at once (handles name their pool by id).
+ * A pool must outlive every reference to its blocks.
+ */
+class PayloadPool {
+  public:
+    static constexpr size_t MAX_POOLS = 4;
+    static constexpr size_t MAX_BLOCKS = 0xFFFF;
+
+    /**
+     * @param blockSize Largest payload in bytes
+     * @param blockCount Number of blocks (at most MAX_BLOCKS)
+     */
+    PayloadPool(size_t blockSize, size_t blockCount);
+    ~PayloadPool();
+
+    // Prevent copying
+    PayloadPool(const PayloadPool&) = delete;
+    PayloadPool& operator=(const PayloadPool&) = delete;
+
+    /**
+     * @brief Copy a payload into a free block (ISR-safe)
+     * @return Reference to the block, empty if the pool is exhausted or size > blockSize
+     */
+    [[nodiscard]] PayloadRef allocate(const void* data, size_t size);
+
+    /**
+     * @brief Copy a value into a free block (read it back with PayloadRef::as<T>())
+     */
+    template <typename T>
+    [[nodiscard]] PayloadRef make(const T& value) {
+        static_assert(std::is_trivially_copyable_v<T>, "Pooled payloads are copied bytewise");
+        return allocate(&value, sizeof(T));
+    }
+
+    [[nodiscard]] PayloadPoolStats getStats() const;
+
+  private:
+    friend class PayloadRef;
+
+    struct Block {
+        std::atomic<uint32_t> refs{0};
+        std::atomic<uint32_t> generation{0};
+        std::atomic<uint32_t> next{0}; // Free list link
+        uint32_t size = 0;
+    };
+
+    static PayloadPool* poolOf(uint32_t handle);
+    Block* blockOf(uint32_t handle) const;
+    const uint8_t* blockData(uint32_t index) const;
+    bool popFree(uint32_t& index);
+    void pushFree(uint32_t index);
+    void retainBlock(uint32_t handle);
+    void releaseBlock(uint32_t handle);
+
+    static std::array<std::atomic<PayloadPool*>, MAX_POOLS> s_pools;
+
+    uint32_t m_id = 0; // Slot in s_pools + 1, 0 if not registered
+    size_t m_blockSize;
+    size_t m_blockCount;
+    size_t m_stride; // Block size in 8-byte words
+    std::unique_ptr<uint64_t[]> m_storage;
+    std::unique_ptr<Block[]> m_blocks;
+    std::atomic<uint32_t> m_freeHead{0}; // ABA tag (16 bits) | index (16 bits)
+    std::atomic<uint32_t> m_inUse{0};
+    std::atomic<uint32_t> m_highWatermark{0};
+    std::atomic<uint32_t> m_failed{0};
+};
@@ -0,0 +1,356 @@
+#pragma once
+
+#include "Event.h"
+#include "IEventBus.h"
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include <array>
+#include <bit>
+#include <concepts>
+#include <cstdio>
+#include <memory>
+#include <span>
+#include <vector>
+
+/**
+ * @brief How ShardedEventBus assigns events to shards
+ */
+enum class ShardRouting : uint8_t {
+    BySource,  // Event::source % shard count - a lane is handled entirely by one shard
+    ByCategory // eventCategory() of the type, see assignCategory()
+};
+
+/**
+ * @brief Requirements of a ShardedEventBus shard
+ *
+ * Any IEventBus with its own queue and a loop task that can be pinned to a
+ * core: FreeRtosEventBus on the target, a std::thread backed bus on the host.
+ */
+template <typename Shard>
+concept EventBusShard = std::derived_from<Shard, IEventBus> &&
+                        requires(Shard shard, uint32_t stackSize, UBaseType_t priority, const char* name,
+                                 BaseType_t core) {
+                            shard.startEventLoop(stackSize, priority, name, core);
+                            shard.stopEventLoop();
+                            { shard.isEventLoopRunning() } -> std::convertible_to<bool>;
+                        };
+
+/**
+ * @brief Event bus split into shards, each with its own queue and loop task
+ *
+ * Every event is routed to exactly one shard, chosen from its lane
+ * (ShardRouting::BySource) or its category (ShardRouting::ByCategory). Each
+ * shard loop runs on its own core, so two lanes, or hardware and bookkeeping
+ * events, are dispatched in parallel instead of sharing one event loop task.
+ *
+ * Ordering: routing depends only on the event, and every shard queue is FIFO
+ * per priority lane, so the events of one source that go to one shard keep
+ * their publish order - also when a handler on another shard publishes them
+ * (cross-shard publish is a plain enqueue on the target shard). With BySource
+ * routing all events of a source share a shard, so their order is total.
+ * With ByCategory routing a source's categories are spread over shards and
+ * dispatched concurrently; a source that must stay ordered is given a home
+ * shard with pinSource(), which then takes all of its events.
+ *
+ * Subscriptions are registered on every shard that can receive the event:
+ * - BySource: the shard of SubscribeOptions::source, or all shards for
+ *   EVENT_SOURCE_ANY. Such a handler may then run on several cores at once
+ *   and must be thread-safe.
+ * - ByCategory: the shard owning the type's category, or the home shard of a
+ *   pinned SubscribeOptions::source. EVENT_SOURCE_ANY handlers are also
+ *   registered on every home shard, and must then be thread-safe.
+ *
+ * publishBatch() is all-or-nothing per shard: a batch spanning shards is split
+ * into per-shard batches of at most MAX_SPLIT_BATCH events, and is rejected
+ * as a whole if a shard would get more.
+ *
+ * Blocking waits happen only in the shard loop tasks; waitForEvent() on the
+ * sharded bus is a non-blocking poll.
+ *
+ * Routing is fixed after construction except for assignCategory() and
+ * pinSource(), which must be called before subscribing.
+ */
+template <EventBusShard Shard>
+class ShardedEventBus : public IEventBus {
+  public:
+    /**
+     * @brief Maximum number of shards
+     */
+    static constexpr size_t MAX_SHARDS = 8;
+
+    /**
+     * @brief Create shardCount shards, each constructed from shardArgs
+     * @param shardCount Number of shards (1..MAX_SHARDS)
+     * @param routing How events are assigned to shards
+     * @param shardArgs Constructor arguments of every shard (e.g. queue sizes)
+     */
+    template <typename... ShardArgs>
+    ShardedEventBus(size_t shardCount, ShardRouting routing, const ShardArgs&... shardArgs)
+        : m_routing(routing) {
+        if (shardCount == 0) {
+            shardCount = 1;
+        } else if (shardCount > MAX_SHARDS) {
+            shardCount = MAX_SHARDS;
+        }
+
+        for (size_t i = 0; i < shardCount; i++) {
+            m_shards.push_back(std::make_unique<Shard>(shardArgs...));
+            m_cores[i] = static_cast<BaseType_t>(i % portNUM_PROCESSORS);
+            snprintf(m_taskNames[i].data(), m_taskNames[i].size(), "event_shard%u", (unsigned) i);
+        }
+
+        // Spread categories round-robin until assignCategory() says otherwise
+        for (size_t bit = 0; bit < EVENT_CATEGORY_COUNT; bit++) {
+            m_categoryShard[bit] = static_cast<uint8_t>(bit % shardCount);
+        }
+        m_sourceShard.fill(NO_HOME_SHARD);
+    }
+
+    ~ShardedEventBus() override {
+        stopEventLoops();
+    }
+
+    // Prevent copying
+    ShardedEventBus(const ShardedEventBus&) = delete;
+    ShardedEventBus& operator=(const ShardedEventBus&) = delete;
+
+    void subscribe(EventType type, EventHandler handler) override {
+        subscribe(type, std::move(handler), SubscribeOptions{});
+    }
+
+    void subscribe(EventType type, EventHandler handler, const SubscribeOptions& options) override {
+        const uint32_t shards = shardsFor(eventCategory(type), options.source);
+        for (uint32_t mask = shards; mask != 0; mask &= mask - 1) {
+            m_shards[std::countr_zero(mask)]->subscribe(type, handler, options);
+        }
+    }
+
+    void subscribeCategory(EventCategoryMask categories, EventHandler handler) override {
+        subscribeCategory(categories, std::move(handler), SubscribeOptions{});
+    }
+
+    void subscribeCategory(EventCategoryMask categories, EventHandler handler,
+                           const SubscribeOptions& options) override {
+        // Each shard only receives its own categories, so the full mask never duplicates calls
+        const uint32_t shards = shardsFor(categories, options.source);
+        for (uint32_t mask = shards; mask != 0; mask &= mask - 1) {
+            m_shards[std::countr_zero(mask)]->subscribeCategory(categories, handler, options);
+        }
+    }
+
+    void publish(const Event& event) override {
+        m_shards[shardFor(event)]->publish(event);
+    }
+
+    bool publishBatch(std::span<const Event> events) override {
+        // Common case: the whole batch belongs to one shard
+        size_t first = events.empty() ? 0 : shardFor(events.front());
+        bool single = true;
+        for (const Event& event : events) {
+            single = single && shardFor(event) == first;
+        }
+        if (single) {
+            return m_shards[first]->publishBatch(events);
+        }
+
+        // Split into one batch per shard on the stack; a shard part must fit, or nothing is queued
+        std::array<size_t, MAX_SHARDS> counts{};
+        for (const Event& event : events) {
+            if (++counts[shardFor(event)] > MAX_SPLIT_BATCH) {
+                return false;
+            }
+        }
+
+        bool queued = true;
+        Event split[MAX_SPLIT_BATCH];
+        for (size_t shard = 0; shard < m_shards.size(); shard++) {
+            if (counts[shard] == 0) {
+                continue;
+            }
+            size_t count = 0;
+            for (const Event& event : events) {
+                if (shardFor(event) == shard) {
+                    split[count++] = event;
+                }
+            }
+            queued = m_shards[shard]->publishBatch(std::span<const Event>(split, count)) && queued;
+        }
+        return queued;
+    }
+
+    /**
+     * @brief Dispatch pending events of all shards in the calling task
+     *
+     * Repeats until no shard has pending events, so cross-shard publishes
+     * made by handlers are dispatched too. For testing without loop tasks.
+     */
+    void processAllPending() override {
+        Event event;
+        bool dispatched = true;
+        while (dispatched) {
+            dispatched = false;
+            for (auto& shard : m_shards) {
+                while (shard->waitForEvent(event, 0)) {
+                    dispatched = true;
+                }
+            }
+        }
+    }
+
+    /**
+     * @brief Dispatch the next pending event of any shard in the calling task
+     *
+     * Never blocks: timeoutMs is ignored. The shards have no common wakeup,
+     * so waiting for events is left to the shard loop tasks; off those tasks
+     * use processAllPending() or poll with this call.
+     */
+    [[nodiscard]] bool waitForEvent(Event& outEvent, uint32_t timeoutMs) override {
+        (void) timeoutMs;
+        for (size_t i = 0; i < m_shards.size(); i++) {
+            size_t shard = (m_nextPoll + i) % m_shards.size();
+            if (m_shards[shard]->waitForEvent(outEvent, 0)) {
+                m_nextPoll = shard + 1;
+                return true;
+            }
+        }
+        return false;
+    }
+
+    /**
+     * @brief Set the core a shard's loop task is pinned to
+     *
+     * Takes effect on the next startEventLoops(). Default: shard % portNUM_PROCESSORS.
+     */
+    void setShardCore(size_t shard, BaseType_t core) {
+        if (shard < m_shards.size()) {
+            m_cores[shard] = core;
+        }
+    }
+
+    /**
+     * @brief Route the categories in a mask to one shard (ByCategory routing)
+     *
+     * Call before subscribing: existing subscriptions stay on their old shard.
+     */
+    void assignCategory(EventCategoryMask categories, size_t shard) {
+        if (shard >= m_shards.size()) {
+            return;
+        }
+        for (size_t bit = 0; bit < EVENT_CATEGORY_COUNT; bit++) {
+            if (categories & (1u << bit)) {
+                m_categoryShard[bit] = static_cast<uint8_t>(shard);
+            }
+        }
+    }
+
+    /**
+     * @brief Route all events of a source to one shard (ByCategory routing)
+     *
+     * Keeps the source's events in publish order (per priority lane)
+     * whatever their category. Call before subscribing: existing subscriptions stay on their
+     * old shard.
+     */
+    void pinSource(uint8_t source, size_t shard) {
+        if (m_routing != ShardRouting::ByCategory || source >= MAX_EVENT_SOURCES || shard >= m_shards.size()) {
+            return;
+        }
+        m_sourceShard[source] = static_cast<uint8_t>(shard);
+    }
+
+    /**
+     * @brief Start one loop task per shard, each pinned to its core
+     */
+    void startEventLoops(uint32_t stackSize = 4096, UBaseType_t priority = 5) {
+        for (size_t i = 0; i < m_shards.size(); i++) {
+            m_shards[i]->startEventLoop(stackSize, priority, m_taskNames[i].data(), m_cores[i]);
+        }
+    }
+
+    /**
+     * @brief Stop all shard loop tasks
+     */
+    void stopEventLoops() {
+        for (auto& shard : m_shards) {
+            if (shard->isEventLoopRunning()) {
+                shard->stopEventLoop();
+            }
+        }
+    }
+
+    /**
+     * @brief Get the shard an event is routed to
+     */
+    [[nodiscard]] size_t shardFor(const Event& event) const {
+        if (m_routing == ShardRouting::BySource) {
+            return event.source % m_shards.size();
+        }
+        if (event.source < MAX_EVENT_SOURCES && m_sourceShard[event.source] != NO_HOME_SHARD) {
+            return m_sourceShard[event.source];
+        }
+        const EventCategoryMask category = eventCategory(event.type);
+        return category ? m_categoryShard[std::countr_zero(static_cast<unsigned>(category))] : 0;
+    }
+
+    [[nodiscard]] size_t shardCount() const {
+        return m_shards.size();
+    }
+
+    [[nodiscard]] Shard& shard(size_t index) {
+        return *m_shards[index];
+    }
+
+    [[nodiscard]] ShardRouting routing() const {
+        return m_routing;
+    }
+
+  private:
+    /**
+     * @brief Most events one shard may get from a batch that spans shards
+     *
+     * One event loop wakeup (FreeRtosEventBus::EVENT_LOOP_BATCH_SIZE); larger
+     * shard parts would have to be chunked and lose all-or-nothing.
+     */
+    static constexpr size_t MAX_SPLIT_BATCH = 8;
+
+    /**
+     * @brief m_sourceShard entry of a source routed by category
+     */
+    static constexpr uint8_t NO_HOME_SHARD = 0xFF;
+
+    /**
+     * @brief Get a bit per shard that can receive events of the categories and source
+     */
+    [[nodiscard]] uint32_t shardsFor(EventCategoryMask categories, uint8_t source) const {
+        const uint32_t all = (1u << m_shards.size()) - 1;
+        if (m_routing == ShardRouting::BySource) {
+            return (source == EVENT_SOURCE_ANY) ? all : (1u << (source % m_shards.size()));
+        }
+
+        // A pinned source only reaches its home shard; any source also reaches every home shard
+        if (source < MAX_EVENT_SOURCES && m_sourceShard[source] != NO_HOME_SHARD) {
+            return 1u << m_sourceShard[source];
+        }
+        uint32_t shards = 0;
+        for (size_t bit = 0; bit < EVENT_CATEGORY_COUNT; bit++) {
+            if (categories & (1u << bit)) {
+                shards |= 1u << m_categoryShard[bit];
+            }
+        }
+        if (source == EVENT_SOURCE_ANY) {
+            for (uint8_t home : m_sourceShard) {
+                if (home != NO_HOME_SHARD) {
+                    shards |= 1u << home;
+                }
+            }
+        }
+        return shards;
+    }
+
+    ShardRouting m_routing;
+    std::vector<std::unique_ptr<Shard>> m_shards;
+    std::array<BaseType_t, MAX_SHARDS> m_cores{};
+    std::array<std::array<char, 16>, MAX_SHARDS> m_taskNames{}; // Kept alive for host shards
+    std::array<uint8_t, EVENT_CATEGORY_COUNT> m_categoryShard{};
+    std::array<uint8_t, MAX_EVENT_SOURCES> m_sourceShard{}; // Home shard per source, see pinSource()
+    size_t m_nextPoll = 0;
+};
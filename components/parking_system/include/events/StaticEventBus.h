@@ -0,0 +1,312 @@
+#pragma once
+
+#include "Event.h"
+#include "EventDispatchTable.h"
+#include "FreeRtosEventBus.h"
+#include "IEventBus.h"
+#include "esp_log.h"
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <tuple>
+#include <utility>
+
+/**
+ * @brief Check if a subscriber type has a handler for event type T
+ */
+template <typename Subscriber, EventType T>
+concept HandlesEvent = requires(Subscriber& subscriber, const Event& event) {
+    subscriber.handle(EventTag<T>{}, event);
+};
+
+/**
+ * @brief Event bus with a subscriber set fixed at compile time
+ *
+ * Each subscriber type declares its handlers as overloads
+ * handle(EventTag<EventType::X>, const Event&). Dispatch folds over the event
+ * types and the subscriber list, so every handler call is a direct call the
+ * compiler can inline - no EventHandler, table lookup or virtual call between
+ * the queue and the handler. Subscribers of a type run in list order.
+ *
+ * Queueing is FreeRtosEventBus itself (see queue()): priority lanes, overflow
+ * policies, coalescing, ISR rings, trace and latency statistics behave exactly
+ * as on the runtime bus. Inline dispatch does not apply; events published by
+ * handlers are queued.
+ *
+ * Subscribers usually need the bus to publish, so they are constructed after
+ * it with SubscriptionMode::Static and attached with bind() before the first
+ * event is dispatched; the event loop does not start before bind(). IEventBus users reach the bus through
+ * StaticEventBusAdapter; runtime subscriptions made there run after the
+ * static subscribers of the type.
+ */
+template <typename... Subscribers>
+class StaticEventBus {
+  public:
+    /**
+     * @param highPriorityQueueSize Capacity of the high priority lane
+     * @param lowPriorityQueueSize Capacity of the low priority lane
+     */
+    explicit StaticEventBus(size_t highPriorityQueueSize = 32, size_t lowPriorityQueueSize = 32)
+        : m_queue(highPriorityQueueSize, lowPriorityQueueSize) {}
+
+    ~StaticEventBus() {
+        stopEventLoop();
+    }
+
+    // Prevent copying
+    StaticEventBus(const StaticEventBus&) = delete;
+    StaticEventBus& operator=(const StaticEventBus&) = delete;
+
+    /**
+     * @brief Attach the subscriber instances (before the first dispatch)
+     */
+    void bind(Subscribers&... subscribers) {
+        m_subscribers = std::make_tuple(&subscribers...);
+        m_bound.store(true, std::memory_order_release);
+    }
+
+    /**
+     * @brief Number of static subscribers that handle event type T
+     */
+    template <EventType T>
+    static constexpr size_t subscriberCount() {
+        return (static_cast<size_t>(HandlesEvent<Subscribers, T>) + ... + 0);
+    }
+
+    void publish(const Event& event) {
+        m_queue.publish(event);
+    }
+
+    bool publishFromISR(const Event& event) {
+        return m_queue.publishFromISR(event);
+    }
+
+    bool publishBatch(std::span<const Event> events) {
+        return m_queue.publishBatch(events);
+    }
+
+    /**
+     * @brief Dispatch all queued events in the calling task (for synchronous testing)
+     */
+    void processAllPending() {
+        if (!isBound()) {
+            return; // Keep events queued until bind()
+        }
+        while (m_queue.dispatchPendingTo(*this, FreeRtosEventBus::EVENT_LOOP_BATCH_SIZE, 0) > 0) {
+        }
+    }
+
+    /**
+     * @brief Wait for the next event and dispatch it
+     */
+    [[nodiscard]] bool waitForEvent(Event& outEvent, uint32_t timeoutMs) {
+        if (!isBound()) {
+            return false;
+        }
+        TickType_t ticks = (timeoutMs == portMAX_DELAY) ? portMAX_DELAY : pdMS_TO_TICKS(timeoutMs);
+        bool received = false;
+        auto dispatchOne = [this, &outEvent, &received](const Event& event) {
+            outEvent = event;
+            received = true;
+            dispatch(event);
+        };
+        // A coalesced entry whose levels cancelled out dispatches nothing: take the next one
+        while (!received && m_queue.dispatchPendingTo(dispatchOne, 1, ticks) > 0) {
+        }
+        return received;
+    }
+
+    /**
+     * @brief Call the handlers of an event's type (the queue's dispatcher)
+     */
+    void operator()(const Event& event) {
+        dispatch(event);
+    }
+
+    void dispatch(const Event& event) {
+        dispatchByType(event, std::make_index_sequence<EVENT_TYPE_COUNT>{});
+        if (m_runtimeMask & (1u << eventTypeIndex(event.type))) {
+            m_runtime.dispatch(event);
+        }
+    }
+
+    /**
+     * @brief Add a runtime handler, called after the static subscribers
+     *
+     * The runtime table is not synchronized with dispatch: subscriptions are
+     * refused while the event loop task runs. Async workers are not supported
+     * and handlers are not profiled (name and budgetUs are ignored).
+     */
+    void subscribeRuntime(EventType type, EventHandler handler, const SubscribeOptions& options = {}) {
+        if (!acceptsRuntimeSubscription(options)) {
+            return;
+        }
+        m_runtime.add(type, std::move(handler), nullptr, options.filter, options.source);
+        m_runtimeMask |= 1u << eventTypeIndex(type);
+    }
+
+    /**
+     * @brief Add a runtime category handler, called after the static subscribers (same limits as subscribeRuntime())
+     */
+    void subscribeRuntimeCategory(EventCategoryMask categories, EventHandler handler,
+                                  const SubscribeOptions& options = {}) {
+        if (!acceptsRuntimeSubscription(options)) {
+            return;
+        }
+        if (m_runtime.addCategory(categories, std::move(handler), nullptr, options.source)) {
+            for (size_t i = 0; i < EVENT_TYPE_COUNT; i++) {
+                if (eventCategory(static_cast<EventType>(i)) & categories) {
+                    m_runtimeMask |= 1u << i;
+                }
+            }
+        }
+    }
+
+    /**
+     * @brief Start the event loop task on the queue's lanes (subscribers must be bound)
+     */
+    void startEventLoop(uint32_t stackSize = 4096, UBaseType_t priority = 5,
+                        const char* taskName = "event_loop", BaseType_t core = tskNO_AFFINITY) {
+        if (!isBound()) {
+            ESP_LOGE("StaticEventBus", "Cannot start event loop before bind()");
+            return;
+        }
+        m_queue.startLoopTask(eventLoopTask, this, stackSize, priority, taskName, core);
+    }
+
+    void stopEventLoop() {
+        if (m_queue.m_eventLoopTask != nullptr) {
+            m_queue.stopEventLoop();
+        }
+    }
+
+    [[nodiscard]] bool isEventLoopRunning() const {
+        return m_queue.isEventLoopRunning();
+    }
+
+    /**
+     * @brief Get the queue for policies, coalescing, ISR rings and statistics
+     */
+    [[nodiscard]] FreeRtosEventBus& queue() {
+        return m_queue;
+    }
+
+  private:
+    [[nodiscard]] bool isBound() const {
+        return m_bound.load(std::memory_order_acquire);
+    }
+
+    [[nodiscard]] bool acceptsRuntimeSubscription(const SubscribeOptions& options) const {
+        const char* name = options.name ? options.name : "unnamed";
+        if (m_queue.m_eventLoopTask != nullptr) {
+            ESP_LOGE("StaticEventBus", "Runtime subscriber %s refused: event loop running", name);
+            return false;
+        }
+        if (options.async || options.worker) {
+            ESP_LOGE("StaticEventBus", "Runtime subscriber %s refused: async handlers not supported", name);
+            return false;
+        }
+        if (options.source >= MAX_EVENT_SOURCES && options.source != EVENT_SOURCE_ANY) {
+            ESP_LOGE("StaticEventBus", "Runtime subscriber %s refused: source %u out of range", name,
+                     (unsigned) options.source);
+            return false;
+        }
+        if (options.budgetUs > 0) {
+            ESP_LOGW("StaticEventBus", "Runtime subscriber %s: handlers are not profiled, budget ignored", name);
+        }
+        return true;
+    }
+
+    template <size_t... Index>
+    void dispatchByType(const Event& event, std::index_sequence<Index...>) {
+        // Compiles to a switch over the type; types without subscribers are empty cases
+        const size_t index = eventTypeIndex(event.type);
+        (void) ((index == Index && (deliver<static_cast<EventType>(Index)>(event), true)) || ...);
+    }
+
+    template <EventType T>
+    void deliver(const Event& event) {
+        if constexpr (subscriberCount<T>() > 0) {
+            std::apply([&event](Subscribers*... subscribers) { (deliverTo<T>(*subscribers, event), ...); },
+                       m_subscribers);
+        }
+    }
+
+    template <EventType T, typename Subscriber>
+    static void deliverTo(Subscriber& subscriber, const Event& event) {
+        if constexpr (HandlesEvent<Subscriber, T>) {
+            subscriber.handle(EventTag<T>{}, event);
+        }
+    }
+
+    static void eventLoopTask(void* pvParameters) {
+        auto* self = static_cast<StaticEventBus*>(pvParameters);
+        // Blocks on the queue's wakeup, like the runtime loop (only started once bound)
+        while (!self->m_queue.loopStopRequested()) {
+            (void) self->m_queue.dispatchPendingTo(*self, FreeRtosEventBus::EVENT_LOOP_BATCH_SIZE, portMAX_DELAY);
+        }
+
+        // Must be the last access to self: the bus may be destroyed once joined
+        self->m_queue.signalLoopExited();
+        vTaskDelete(nullptr);
+    }
+
+    FreeRtosEventBus m_queue;
+    std::tuple<Subscribers*...> m_subscribers{};
+    std::atomic<bool> m_bound{false};
+    EventDispatchTable m_runtime;  // IEventBus subscriptions made through the adapter
+    uint32_t m_runtimeMask = 0;    // Bit per event type with runtime handlers
+};
+
+static_assert(EVENT_TYPE_COUNT <= 32, "StaticEventBus runtime mask holds 32 event types");
+
+/**
+ * @brief IEventBus view of a StaticEventBus
+ *
+ * Lets components written against IEventBus (controllers, tests, console
+ * helpers) use a StaticEventBus. subscribe() adds runtime handlers that run
+ * after the static subscribers; the static dispatch path is unaffected.
+ */
+template <typename Bus>
+class StaticEventBusAdapter : public IEventBus {
+  public:
+    explicit StaticEventBusAdapter(Bus& bus)
+        : m_bus(bus) {}
+
+    void subscribe(EventType type, EventHandler handler) override {
+        m_bus.subscribeRuntime(type, std::move(handler));
+    }
+
+    void subscribe(EventType type, EventHandler handler, const SubscribeOptions& options) override {
+        m_bus.subscribeRuntime(type, std::move(handler), options);
+    }
+
+    void subscribeCategory(EventCategoryMask categories, EventHandler handler) override {
+        m_bus.subscribeRuntimeCategory(categories, std::move(handler));
+    }
+
+    void subscribeCategory(EventCategoryMask categories, EventHandler handler,
+                           const SubscribeOptions& options) override {
+        m_bus.subscribeRuntimeCategory(categories, std::move(handler), options);
+    }
+
+    void publish(const Event& event) override {
+        m_bus.publish(event);
+    }
+
+    bool publishBatch(std::span<const Event> events) override {
+        return m_bus.publishBatch(events);
+    }
+
+    void processAllPending() override {
+        m_bus.processAllPending();
+    }
+
+    [[nodiscard]] bool waitForEvent(Event& outEvent, uint32_t timeoutMs) override {
+        return m_bus.waitForEvent(outEvent, timeoutMs);
+    }
+
+  private:
+    Bus& m_bus;
+};
@@ -43,13 +43,17 @@ class EntryGateController {
      * @param gate Gate abstraction (barrier + light barrier)
      * @param ticketService Ticket service
      * @param barrierTimeoutMs Barrier open/close timeout in ms
+     * @param laneId Event source of this gate's lane (Event::source)
+     * @param mode Runtime: subscribe on eventBus; Static: StaticEventBus calls handle()
      */
     EntryGateController(
         IEventBus& eventBus,
         IGpioInput& button,
         IGate& gate,
         ITicketService& ticketService,
-        uint32_t barrierTimeoutMs = 2000);
+        uint32_t barrierTimeoutMs = 2000,
+        uint8_t laneId = 0,
+        SubscriptionMode mode = SubscriptionMode::Runtime);
 
     ~EntryGateController();
 
@@ -96,12 +100,36 @@ class EntryGateController {
     }
 #endif
 
+    /**
+     * @brief StaticEventBus handlers (SubscriptionMode::Static), limited to this lane
+     */
+    void handle(EventTag<EventType::EntryButtonPressed>, const Event& event) {
+        if (event.source == m_laneId) {
+            onButtonPressed(event);
+        }
+    }
+    void handle(EventTag<EventType::EntryLightBarrierBlocked>, const Event& event) {
+        if (event.source == m_laneId) {
+            onLightBarrierBlocked(event);
+        }
+    }
+    void handle(EventTag<EventType::EntryLightBarrierCleared>, const Event& event) {
+        if (event.source == m_laneId) {
+            onLightBarrierCleared(event);
+        }
+    }
+
   private:
     void onButtonPressed(const Event& event);
     void onLightBarrierBlocked(const Event& event);
     void onLightBarrierCleared(const Event& event);
     void onBarrierTimeout();
 
+    /**
+     * @brief Build an event of this gate's lane
+     */
+    Event makeEvent(EventType type, EventPayload payload = std::monostate{}) const;
+
     void setState(EntryGateState newState);
     void startBarrierTimer();
     void stopBarrierTimer();
@@ -116,5 +144,6 @@ class EntryGateController {
     EntryGateState m_state;
     uint32_t m_barrierTimeoutMs;
     uint32_t m_currentTicketId;
+    uint8_t m_laneId; // Source of published events, only this lane's events are handled
     TimerHandle_t m_barrierTimer;
 };
@@ -41,13 +41,17 @@ class ExitGateController {
      * @param ticketService Ticket service
      * @param barrierTimeoutMs Barrier open/close timeout in ms
      * @param validationTimeMs Ticket validation simulation time in ms
+     * @param laneId Event source of this gate's lane (Event::source)
+     * @param mode Runtime: subscribe on eventBus; Static: StaticEventBus calls handle()
      */
     ExitGateController(
         IEventBus& eventBus,
         IGate& gate,
         ITicketService& ticketService,
         uint32_t barrierTimeoutMs = 2000,
-        uint32_t validationTimeMs = 500);
+        uint32_t validationTimeMs = 500,
+        uint8_t laneId = 0,
+        SubscriptionMode mode = SubscriptionMode::Runtime);
 
     ~ExitGateController();
 
@@ -99,12 +103,31 @@ class ExitGateController {
     }
 #endif
 
+    /**
+     * @brief StaticEventBus handlers (SubscriptionMode::Static), limited to this lane
+     */
+    void handle(EventTag<EventType::ExitLightBarrierBlocked>, const Event& event) {
+        if (event.source == m_laneId) {
+            onLightBarrierBlocked(event);
+        }
+    }
+    void handle(EventTag<EventType::ExitLightBarrierCleared>, const Event& event) {
+        if (event.source == m_laneId) {
+            onLightBarrierCleared(event);
+        }
+    }
+
   private:
     void onLightBarrierBlocked(const Event& event);
     void onLightBarrierCleared(const Event& event);
     void onBarrierTimeout();
     void onValidationTimeout();
 
+    /**
+     * @brief Build an event of this gate's lane
+     */
+    Event makeEvent(EventType type, EventPayload payload = std::monostate{}) const;
+
     void setState(ExitGateState newState);
     void startBarrierTimer();
     void stopBarrierTimer();
@@ -122,6 +145,7 @@ class ExitGateController {
     uint32_t m_barrierTimeoutMs;
     uint32_t m_validationTimeMs;
     uint32_t m_currentTicketId;
+    uint8_t m_laneId; // Source of published events, only this lane's events are handled
     TimerHandle_t m_barrierTimer;
     TimerHandle_t m_validationTimer;
 };
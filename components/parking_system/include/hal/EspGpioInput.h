@@ -1,6 +1,7 @@
 #pragma once
 
 #include "IGpioInput.h"
+#include "IsrEventRing.h"
 #include "driver/gpio.h"
 #include "esp_attr.h"
 #include <functional>
@@ -14,6 +15,7 @@
  * - Interrupt on both edges (rising and falling)
  * - IRAM-safe interrupt handler
  * - Software debouncing for buttons
+ * - Optional zero-allocation ISR path into an IsrEventRing
  */
 class EspGpioInput : public IGpioInput {
   public:
@@ -34,6 +36,17 @@ class EspGpioInput : public IGpioInput {
     void enableInterrupt() override;
     void disableInterrupt() override;
 
+    /**
+     * @brief Route interrupts into an event bus ring instead of the handler
+     *
+     * The ISR then only captures level and timestamp and pushes them to the
+     * ring; no std::function call and no queue send happens in interrupt
+     * context. Set before enableInterrupt().
+     *
+     * @param ring Ring created by FreeRtosEventBus::createIsrEventRing()
+     */
+    void setIsrEventRing(IsrEventRing* ring);
+
     /**
      * @brief Simulate an interrupt for testing purposes
      *
@@ -52,5 +65,6 @@ class EspGpioInput : public IGpioInput {
     gpio_num_t m_pin;
     uint32_t m_debounceMs;
     std::function<void(bool)> m_handler;
+    IsrEventRing* m_isrRing;
     int64_t m_lastInterruptTime;
 };
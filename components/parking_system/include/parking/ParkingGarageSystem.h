@@ -41,7 +41,7 @@ class ParkingGarageSystem {
     /**
      * @brief Get event bus reference
      */
-    IEventBus& getEventBus() { return *m_eventBus; }
+    FreeRtosEventBus& getEventBus() { return *m_eventBus; }
 
     /**
      * @brief Get ticket service reference
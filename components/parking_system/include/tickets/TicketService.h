@@ -10,6 +10,11 @@
  *
  * Uses FreeRTOS mutex for thread-safety.
  * Stores tickets in memory (no persistence).
+ *
+ * Used tickets stay in the map, so occupancy is kept as a counter updated on
+ * issue, use and reset instead of being counted on every button press.
+ * With CONFIG_PARKING_TICKET_COUNT_CHECK every change is followed by a full
+ * reconciliation scan.
  */
 class TicketService : public ITicketService {
   public:
@@ -33,9 +38,19 @@ class TicketService : public ITicketService {
     void reset() override;
     void setCapacity(uint32_t capacity) override;
 
+    /**
+     * @brief Recount active tickets and correct the occupancy counter (O(n))
+     * @return true if the counter matched the tickets
+     */
+    bool reconcileActiveTicketCount();
+
   private:
+    bool reconcileLocked();
+    void checkActiveCountLocked();
+
     uint32_t m_capacity;
     uint32_t m_nextTicketId;
+    uint32_t m_activeCount; // Issued and not yet used
     std::map<uint32_t, Ticket> m_tickets;
     mutable SemaphoreHandle_t m_mutex;
 };
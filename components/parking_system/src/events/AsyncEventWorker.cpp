@@ -0,0 +1,227 @@
+#include "AsyncEventWorker.h"
+#include "esp_log.h"
+#include "esp_timer.h"
+
+static const char* TAG = "AsyncEventWorker";
+
+// Longest wait for the task to finish its current handler on stop()
+static constexpr uint32_t STOP_TIMEOUT_MS = 1000;
+
+AsyncEventWorker::AsyncEventWorker(const AsyncWorkerConfig& config)
+    : m_config(config) {
+    m_tables.push_back(std::make_unique<EventDispatchTable>());
+    m_table.store(m_tables.back().get(), std::memory_order_relaxed);
+
+    m_queue = xQueueCreate(m_config.queueSize, sizeof(PackedEvent));
+    if (!m_queue) {
+        ESP_LOGE(TAG, "Failed to create queue for %s", m_config.name);
+    }
+
+    m_mutex = xSemaphoreCreateMutex();
+    if (!m_mutex) {
+        ESP_LOGE(TAG, "Failed to create mutex for %s", m_config.name);
+    }
+
+    m_exited = xSemaphoreCreateBinary();
+    if (!m_exited) {
+        ESP_LOGE(TAG, "Failed to create exit semaphore for %s", m_config.name);
+    }
+}
+
+AsyncEventWorker::~AsyncEventWorker() {
+    if (m_task != nullptr) {
+        stop();
+    }
+
+    if (m_queue) {
+        // Undelivered events still hold references to pooled payloads
+        PackedEvent packed;
+        while (xQueueReceive(m_queue, &packed, 0) == pdTRUE) {
+            releasePayload(packed);
+        }
+        vQueueDelete(m_queue);
+    }
+    if (m_mutex) {
+        vSemaphoreDelete(m_mutex);
+    }
+    if (m_exited) {
+        vSemaphoreDelete(m_exited);
+    }
+}
+
+bool AsyncEventWorker::subscribe(EventType type, EventHandler handler, HandlerProfile* profile,
+                                 PayloadFilter filter, uint8_t source) {
+    bool first = false;
+    if (xSemaphoreTake(m_mutex, portMAX_DELAY) == pdTRUE) {
+        EventDispatchTable* table = beginTableUpdate();
+        table->add(type, std::move(handler), profile, filter, source);
+        commitTableUpdate(table);
+
+        uint32_t bit = 1u << eventTypeIndex(type);
+        first = (m_forwardedMask & bit) == 0;
+        m_forwardedMask |= bit;
+        xSemaphoreGive(m_mutex);
+    }
+    return first;
+}
+
+uint32_t AsyncEventWorker::subscribeCategory(EventCategoryMask categories, EventHandler handler,
+                                             HandlerProfile* profile, uint8_t source) {
+    uint32_t forward = 0;
+    if (xSemaphoreTake(m_mutex, portMAX_DELAY) == pdTRUE) {
+        EventDispatchTable* table = beginTableUpdate();
+        if (table->addCategory(categories, std::move(handler), profile, source)) {
+            for (size_t i = 0; i < EVENT_TYPE_COUNT; i++) {
+                if (eventCategory(static_cast<EventType>(i)) & categories) {
+                    forward |= 1u << i;
+                }
+            }
+            forward &= ~m_forwardedMask;
+            m_forwardedMask |= forward;
+        } else {
+            ESP_LOGE(TAG, "%s: category handler limit reached", m_config.name);
+        }
+        commitTableUpdate(table);
+        xSemaphoreGive(m_mutex);
+    }
+    return forward;
+}
+
+EventDispatchTable* AsyncEventWorker::beginTableUpdate() {
+    // Always copy-on-write: dispatch picks up the table without the mutex
+    m_tables.push_back(std::make_unique<EventDispatchTable>(*m_tables.back()));
+    return m_tables.back().get();
+}
+
+void AsyncEventWorker::commitTableUpdate(EventDispatchTable* table) {
+    m_table.store(table, std::memory_order_seq_cst);
+
+    // Grace period: with no reader registered after the swap, older tables are unreachable
+    if (m_tableReaders.load(std::memory_order_seq_cst) == 0 && m_taskReaders.load(std::memory_order_seq_cst) == 0) {
+        m_tables.erase(m_tables.begin(), m_tables.end() - 1);
+    }
+}
+
+bool AsyncEventWorker::accepts(const Event& event) const {
+    m_tableReaders.fetch_add(1, std::memory_order_seq_cst);
+    const bool wanted = m_table.load(std::memory_order_seq_cst)->wants(event);
+    m_tableReaders.fetch_sub(1, std::memory_order_release);
+    return wanted;
+}
+
+bool AsyncEventWorker::post(const Event& event) {
+    PackedEvent packed = packEvent(event);
+    retainPayload(packed);
+    if (!m_queue || xQueueSend(m_queue, &packed, 0) != pdTRUE) {
+        releasePayload(packed);
+        // Log the first drop only, like the bus lanes
+        if (m_dropped.fetch_add(1, std::memory_order_relaxed) == 0) {
+            ESP_LOGW(TAG, "%s queue full, dropping %s (further drops are only counted)", m_config.name,
+                     eventTypeToString(event.type));
+        }
+        return false;
+    }
+
+    uint32_t queued = m_queued.fetch_add(1, std::memory_order_relaxed) + 1;
+    uint32_t peak = m_highWatermark.load(std::memory_order_relaxed);
+    while (queued > peak && !m_highWatermark.compare_exchange_weak(peak, queued, std::memory_order_relaxed)) {
+    }
+    return true;
+}
+
+size_t AsyncEventWorker::processPending() {
+    size_t count = 0;
+    PackedEvent packed;
+    while (m_queue && xQueueReceive(m_queue, &packed, 0) == pdTRUE) {
+        if (packed.type == STOP_TOKEN) {
+            continue;
+        }
+        dispatch(packed, m_tableReaders);
+        count++;
+    }
+    return count;
+}
+
+void AsyncEventWorker::dispatch(const PackedEvent& packed, std::atomic<uint32_t>& readers) {
+    m_queued.fetch_sub(1, std::memory_order_relaxed);
+    Event event = unpackEvent(packed, esp_timer_get_time());
+
+    // Register before loading the table so commitTableUpdate() cannot free it; no lock taken
+    readers.fetch_add(1, std::memory_order_seq_cst);
+    m_table.load(std::memory_order_seq_cst)->dispatch(event);
+    readers.fetch_sub(1, std::memory_order_release);
+    m_delivered.fetch_add(1, std::memory_order_relaxed);
+}
+
+void AsyncEventWorker::start() {
+    if (m_task != nullptr) {
+        return;
+    }
+
+    (void) xSemaphoreTake(m_exited, 0); // Clear exit signal of a previous run
+    BaseType_t result = xTaskCreatePinnedToCore(workerTask, m_config.name, m_config.stackSize, this,
+                                                m_config.priority, &m_task, m_config.core);
+    if (result == pdPASS) {
+        ESP_LOGI(TAG, "%s started (queue: %u, stack: %lu, priority: %u)", m_config.name,
+                 (unsigned) m_config.queueSize, (unsigned long) m_config.stackSize, (unsigned) m_config.priority);
+    } else {
+        ESP_LOGE(TAG, "Failed to create %s task", m_config.name);
+        m_task = nullptr;
+    }
+}
+
+void AsyncEventWorker::stop() {
+    if (m_task == nullptr) {
+        return;
+    }
+
+    // Jump the queue so stop does not wait for a backlog of slow handlers
+    PackedEvent token{};
+    token.type = STOP_TOKEN;
+    if (xQueueSendToFront(m_queue, &token, pdMS_TO_TICKS(STOP_TIMEOUT_MS)) != pdTRUE ||
+        xSemaphoreTake(m_exited, pdMS_TO_TICKS(STOP_TIMEOUT_MS)) != pdTRUE) {
+        ESP_LOGE(TAG, "%s did not exit within %u ms, deleting task", m_config.name, (unsigned) STOP_TIMEOUT_MS);
+        vTaskDelete(m_task);
+        m_taskReaders.store(0, std::memory_order_release); // The deleted task may have been inside dispatch()
+    }
+    m_task = nullptr;
+
+    ESP_LOGI(TAG, "%s stopped", m_config.name);
+}
+
+bool AsyncEventWorker::isRunning() const {
+    return m_task != nullptr;
+}
+
+AsyncWorkerStats AsyncEventWorker::getStats() const {
+    AsyncWorkerStats stats;
+    stats.name = m_config.name;
+    stats.capacity = m_config.queueSize;
+    stats.delivered = m_delivered.load(std::memory_order_relaxed);
+    stats.dropped = m_dropped.load(std::memory_order_relaxed);
+    stats.queued = m_queued.load(std::memory_order_relaxed);
+    stats.highWatermark = m_highWatermark.load(std::memory_order_relaxed);
+    return stats;
+}
+
+void AsyncEventWorker::resetStats() {
+    m_delivered.store(0, std::memory_order_relaxed);
+    m_dropped.store(0, std::memory_order_relaxed);
+    m_highWatermark.store(m_queued.load(std::memory_order_relaxed), std::memory_order_relaxed);
+}
+
+void AsyncEventWorker::workerTask(void* pvParameters) {
+    auto* self = static_cast<AsyncEventWorker*>(pvParameters);
+
+    PackedEvent packed;
+    while (xQueueReceive(self->m_queue, &packed, portMAX_DELAY) == pdTRUE) {
+        if (packed.type == STOP_TOKEN) {
+            break;
+        }
+        self->dispatch(packed, self->m_taskReaders);
+    }
+
+    // Must be the last access to self: the worker may be destroyed once joined
+    xSemaphoreGive(self->m_exited);
+    vTaskDelete(nullptr);
+}
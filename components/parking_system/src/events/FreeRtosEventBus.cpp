@@ -1,13 +1,61 @@
 #include "FreeRtosEventBus.h"
 #include "esp_log.h"
 #include "esp_timer.h"
+#include <bit>
 
 static const char* TAG = "FreeRtosEventBus";
 
-FreeRtosEventBus::FreeRtosEventBus(size_t queueSize) {
-    m_queue = xQueueCreate(queueSize, sizeof(Event));
-    if (!m_queue) {
-        ESP_LOGE(TAG, "Failed to create event queue");
+static_assert(EVENT_TYPE_COUNT <= 32, "Parked event mask holds one bit per event type");
+
+namespace {
+
+/**
+ * @brief Bit mask of the event types served by a lane
+ */
+constexpr uint32_t laneTypeMask(EventPriority priority) {
+    uint32_t mask = 0;
+    for (size_t i = 0; i < EVENT_TYPE_COUNT; i++) {
+        if (eventPriority(static_cast<EventType>(i)) == priority) {
+            mask |= 1u << i;
+        }
+    }
+    return mask;
+}
+
+template <typename T>
+void updateMax(std::atomic<T>& target, T value) {
+    T current = target.load(std::memory_order_relaxed);
+    while (value > current && !target.compare_exchange_weak(current, value, std::memory_order_relaxed)) {
+    }
+}
+
+} // namespace
+
+FreeRtosEventBus::FreeRtosEventBus(size_t highPriorityQueueSize, size_t lowPriorityQueueSize) {
+    m_tables.push_back(std::make_unique<EventDispatchTable>());
+    m_subscribers.store(m_tables.back().get(), std::memory_order_relaxed);
+
+    m_lanes[static_cast<size_t>(EventPriority::High)].size = highPriorityQueueSize;
+    m_lanes[static_cast<size_t>(EventPriority::Low)].size = lowPriorityQueueSize;
+    for (Lane& lane : m_lanes) {
+        lane.queue = xQueueCreate(lane.size, sizeof(PackedEvent));
+        if (!lane.queue) {
+            ESP_LOGE(TAG, "Failed to create event queue");
+        }
+        lane.slotFreed = xSemaphoreCreateBinary();
+        if (!lane.slotFreed) {
+            ESP_LOGE(TAG, "Failed to create slot semaphore");
+        }
+    }
+
+    m_wakeup = xSemaphoreCreateBinary();
+    if (!m_wakeup) {
+        ESP_LOGE(TAG, "Failed to create wakeup semaphore");
+    }
+
+    m_loopExited = xSemaphoreCreateBinary();
+    if (!m_loopExited) {
+        ESP_LOGE(TAG, "Failed to create event loop exit semaphore");
     }
 
     m_mutex = xSemaphoreCreateMutex();
@@ -15,124 +63,1117 @@ FreeRtosEventBus::FreeRtosEventBus(size_t queueSize) {
         ESP_LOGE(TAG, "Failed to create mutex");
     }
 
-    ESP_LOGI(TAG, "EventBus created (queue size: %d)", queueSize);
+    m_boostLock = xSemaphoreCreateMutex();
+    if (!m_boostLock) {
+        ESP_LOGE(TAG, "Failed to create priority boost mutex");
+    }
+
+    ESP_LOGI(TAG, "EventBus created (high lane: %u, low lane: %u, %u bytes)",
+             (unsigned) highPriorityQueueSize, (unsigned) lowPriorityQueueSize,
+             (unsigned) ((highPriorityQueueSize + lowPriorityQueueSize) * sizeof(PackedEvent)));
 }
 
 FreeRtosEventBus::~FreeRtosEventBus() {
     // Stop event loop first to prevent access to deleted resources
-    stopEventLoop();
+    if (m_eventLoopTask != nullptr) {
+        stopEventLoop();
+    }
+
+    // Undelivered events still hold references to pooled payloads
+    PackedEvent batch[EVENT_LOOP_BATCH_SIZE];
+    size_t count;
+    while ((count = takeAvailable(batch, EVENT_LOOP_BATCH_SIZE)) > 0) {
+        for (size_t i = 0; i < count; i++) {
+            releasePayload(batch[i]);
+        }
+    }
+    for (; m_inlineCount > 0; m_inlineCount--) {
+        releasePayload(m_inlineFifo[m_inlineHead]);
+        m_inlineHead = (m_inlineHead + 1) % INLINE_FIFO_SIZE;
+    }
 
-    if (m_queue) {
-        vQueueDelete(m_queue);
+    for (Lane& lane : m_lanes) {
+        if (lane.queue) {
+            vQueueDelete(lane.queue);
+        }
+        if (lane.slotFreed) {
+            vSemaphoreDelete(lane.slotFreed);
+        }
+    }
+    if (m_wakeup) {
+        vSemaphoreDelete(m_wakeup);
+    }
+    if (m_loopExited) {
+        vSemaphoreDelete(m_loopExited);
     }
     if (m_mutex) {
         vSemaphoreDelete(m_mutex);
     }
+    if (m_boostLock) {
+        vSemaphoreDelete(m_boostLock);
+    }
+}
+
+void FreeRtosEventBus::subscribe(EventType type, EventHandler handler) {
+    subscribe(type, std::move(handler), SubscribeOptions{});
+}
+
+void FreeRtosEventBus::subscribe(EventType type, EventHandler handler, const SubscribeOptions& options) {
+    if (!acceptsSource(options)) {
+        return;
+    }
+    if (xSemaphoreTake(m_mutex, portMAX_DELAY) == pdTRUE) {
+        m_profiles.push_back(std::make_unique<HandlerProfile>(type, options));
+        HandlerProfile* profile = m_profiles.back().get();
+        const char* name = options.name ? options.name : "unnamed";
+
+        if (options.async || options.worker) {
+            AsyncEventWorker* worker = options.worker;
+            if (!worker) {
+                if (!m_defaultWorker) {
+                    m_defaultWorker = createAsyncWorkerLocked(AsyncWorkerConfig{});
+                }
+                worker = m_defaultWorker;
+            }
+
+            // One forwarding handler per worker and type; it only queues events a worker handler wants
+            if (worker->subscribe(type, std::move(handler), profile, options.filter, options.source)) {
+                addToTable(type, asyncForwarder(worker), nullptr, "async forwarder");
+            }
+            ESP_LOGI(TAG, "Async subscriber %s added for event: %s", name, eventTypeToString(type));
+        } else {
+            addToTable(type, std::move(handler), profile, name, options.filter, options.source);
+        }
+        xSemaphoreGive(m_mutex);
+    }
+}
+
+void FreeRtosEventBus::addToTable(EventType type, EventHandler handler, HandlerProfile* profile, const char* name,
+                                  PayloadFilter filter, uint8_t source) {
+    EventDispatchTable* table = beginTableUpdate();
+    table->add(type, std::move(handler), profile, filter, source);
+    commitTableUpdate(table);
+    ESP_LOGI(TAG, "%s %s added for event: %s", m_sealed.load(std::memory_order_relaxed) ? "Late subscriber" : "Subscriber",
+             name, eventTypeToString(type));
+}
+
+EventDispatchTable* FreeRtosEventBus::beginTableUpdate() {
+    // Unsealed readers register under m_mutex (held here), so none can start while the table is edited
+    if (!m_sealed.load(std::memory_order_relaxed) && m_tableReaders.load(std::memory_order_acquire) == 0 &&
+        m_loopReaders.load(std::memory_order_acquire) == 0) {
+        return m_subscribers.load(std::memory_order_relaxed);
+    }
+
+    // Copy-on-write: readers keep using the old table until commitTableUpdate() swaps it
+    m_tables.push_back(std::make_unique<EventDispatchTable>(*m_tables.back()));
+    return m_tables.back().get();
+}
+
+void FreeRtosEventBus::commitTableUpdate(EventDispatchTable* table) {
+    m_subscribers.store(table, std::memory_order_seq_cst);
+
+    // Grace period: with no reader registered after the swap, older tables are unreachable
+    if (m_tables.size() > 1 && m_tableReaders.load(std::memory_order_seq_cst) == 0 &&
+        m_loopReaders.load(std::memory_order_seq_cst) == 0) {
+        m_tables.erase(m_tables.begin(), m_tables.end() - 1);
+    }
+}
+
+std::atomic<uint32_t>& FreeRtosEventBus::tableReaders() {
+    // The loop task counts apart, so a forced delete can drop its registrations
+    return (xTaskGetCurrentTaskHandle() == m_eventLoopTask) ? m_loopReaders : m_tableReaders;
+}
+
+const EventDispatchTable* FreeRtosEventBus::acquireTable(std::atomic<uint32_t>& readers) {
+    if (m_sealed.load(std::memory_order_acquire)) {
+        // Sealed table is never edited in place - no lock needed. Registering before the load
+        // (both seq_cst) lets commitTableUpdate() free old tables once it sees no reader.
+        readers.fetch_add(1, std::memory_order_seq_cst);
+        return m_subscribers.load(std::memory_order_seq_cst);
+    }
+
+    // The mutex only covers picking up the table, never the handler calls
+    const EventDispatchTable* table = nullptr;
+    if (xSemaphoreTake(m_mutex, portMAX_DELAY) == pdTRUE) {
+        readers.fetch_add(1, std::memory_order_relaxed);
+        table = m_subscribers.load(std::memory_order_relaxed);
+        xSemaphoreGive(m_mutex);
+    }
+    return table;
+}
+
+void FreeRtosEventBus::releaseTable(std::atomic<uint32_t>& readers) {
+    readers.fetch_sub(1, std::memory_order_release);
+}
+
+void FreeRtosEventBus::subscribeCategory(EventCategoryMask categories, EventHandler handler) {
+    subscribeCategory(categories, std::move(handler), SubscribeOptions{});
+}
+
+void FreeRtosEventBus::subscribeCategory(EventCategoryMask categories, EventHandler handler,
+                                         const SubscribeOptions& options) {
+    if (!acceptsSource(options)) {
+        return;
+    }
+    if (xSemaphoreTake(m_mutex, portMAX_DELAY) == pdTRUE) {
+        m_profiles.push_back(std::make_unique<HandlerProfile>(categories, options));
+        HandlerProfile* profile = m_profiles.back().get();
+        const char* name = options.name ? options.name : "unnamed";
+
+        if (options.async || options.worker) {
+            AsyncEventWorker* worker = options.worker;
+            if (!worker) {
+                if (!m_defaultWorker) {
+                    m_defaultWorker = createAsyncWorkerLocked(AsyncWorkerConfig{});
+                }
+                worker = m_defaultWorker;
+            }
+
+            uint32_t forward = worker->subscribeCategory(categories, std::move(handler), profile, options.source);
+            for (size_t i = 0; i < EVENT_TYPE_COUNT; i++) {
+                if (forward & (1u << i)) {
+                    addToTable(static_cast<EventType>(i), asyncForwarder(worker), nullptr, "async forwarder");
+                }
+            }
+            ESP_LOGI(TAG, "Async category subscriber %s added (categories 0x%02x)", name, (unsigned) categories);
+        } else {
+            EventDispatchTable* table = beginTableUpdate();
+            if (table->addCategory(categories, std::move(handler), profile, options.source)) {
+                ESP_LOGI(TAG, "Category subscriber %s added (categories 0x%02x)", name, (unsigned) categories);
+            } else {
+                ESP_LOGE(TAG, "Cannot add category subscriber %s (limit %u)", name,
+                         (unsigned) EventDispatchTable::MAX_CATEGORY_HANDLERS);
+            }
+            commitTableUpdate(table);
+        }
+        xSemaphoreGive(m_mutex);
+    }
+}
+
+bool FreeRtosEventBus::acceptsSource(const SubscribeOptions& options) {
+    if (options.source >= MAX_EVENT_SOURCES && options.source != EVENT_SOURCE_ANY) {
+        ESP_LOGE(TAG, "Subscriber %s refused: source %u out of range (max %u)", options.name ? options.name : "unnamed",
+                 (unsigned) options.source, (unsigned) MAX_EVENT_SOURCES - 1);
+        return false;
+    }
+    return true;
+}
+
+EventHandler FreeRtosEventBus::asyncForwarder(AsyncEventWorker* worker) {
+    // Filtered or lane-bound observers must not fill the worker queue with events they skip
+    return [worker](const Event& e) {
+        if (worker->accepts(e)) {
+            (void) worker->post(e);
+        }
+    };
+}
+
+AsyncEventWorker* FreeRtosEventBus::createAsyncWorker(const AsyncWorkerConfig& config) {
+    AsyncEventWorker* worker = nullptr;
+    if (xSemaphoreTake(m_mutex, portMAX_DELAY) == pdTRUE) {
+        worker = createAsyncWorkerLocked(config);
+        xSemaphoreGive(m_mutex);
+    }
+    return worker;
 }
 
-void FreeRtosEventBus::subscribe(EventType type, std::function<void(const Event&)> handler) {
+AsyncEventWorker* FreeRtosEventBus::createAsyncWorkerLocked(const AsyncWorkerConfig& config) {
+    m_workers.push_back(std::make_unique<AsyncEventWorker>(config));
+    AsyncEventWorker* worker = m_workers.back().get();
+    if (m_eventLoopTask != nullptr) {
+        worker->start();
+    }
+    return worker;
+}
+
+std::vector<AsyncWorkerStats> FreeRtosEventBus::getAsyncWorkerStats() const {
+    std::vector<AsyncWorkerStats> stats;
     if (xSemaphoreTake(m_mutex, portMAX_DELAY) == pdTRUE) {
-        m_subscribers[type].push_back(std::move(handler));
-        ESP_LOGI(TAG, "Subscriber added for event: %s", eventTypeToString(type));
+        stats.reserve(m_workers.size());
+        for (const auto& worker : m_workers) {
+            stats.push_back(worker->getStats());
+        }
         xSemaphoreGive(m_mutex);
     }
+    return stats;
+}
+
+size_t FreeRtosEventBus::processAsyncPending() {
+    size_t count = 0;
+    for (auto& worker : m_workers) {
+        count += worker->processPending();
+    }
+    return count;
 }
 
 void FreeRtosEventBus::publish(const Event& event) {
-    if (!m_queue) {
+    if (!laneFor(event.type).queue) {
         ESP_LOGE(TAG, "Cannot publish: queue not initialized");
         return;
     }
 
     // Add timestamp if not set
-    Event timestampedEvent = event;
-    if (timestampedEvent.timestamp == 0) {
-        timestampedEvent.timestamp = esp_timer_get_time();
+    PackedEvent packed = packEvent(event);
+    if (event.timestamp == 0) {
+        packed.timestamp = static_cast<uint32_t>(esp_timer_get_time());
     }
+    retainPayload(packed);
 
-    if (xQueueSend(m_queue, &timestampedEvent, 0) != pdTRUE) {
-        ESP_LOGW(TAG, "Event queue full, dropping event: %s", eventTypeToString(event.type));
+    if (publishInline(packed)) {
+        return;
     }
+    if (enqueue(packed, nullptr)) {
+        xSemaphoreGive(m_wakeup);
+        updatePriorityBoost(0);
+    }
+}
+
+bool FreeRtosEventBus::publishBatch(std::span<const Event> events) {
+    if (events.empty()) {
+        return true;
+    }
+
+    auto now = static_cast<uint32_t>(esp_timer_get_time());
+    auto encode = [now](const Event& event) {
+        PackedEvent packed = packEvent(event);
+        if (event.timestamp == 0) {
+            packed.timestamp = now;
+        }
+        return packed;
+    };
+    // Queue item: owns a reference to a pooled payload until dispatched or dropped
+    auto pack = [&encode](const Event& event) {
+        PackedEvent packed = encode(event);
+        retainPayload(packed);
+        return packed;
+    };
+
+    // Inline only as a whole, so the batch stays all-or-nothing
+    if (canPublishInline(events.size())) {
+        for (const auto& event : events) {
+            (void) publishInline(pack(event));
+        }
+        return true;
+    }
+
+    std::array<size_t, EVENT_PRIORITY_COUNT> laneCounts{};
+    for (const auto& event : events) {
+        laneCounts[static_cast<size_t>(eventPriority(event.type))]++;
+        notePublished(encode(event));
+    }
+
+    // Reserve all slots up front: the batch is queued completely or not at all
+    for (size_t i = 0; i < EVENT_PRIORITY_COUNT; i++) {
+        if (laneCounts[i] == 0) {
+            continue;
+        }
+        if (!m_lanes[i].queue || !reserveSlots(m_lanes[i], laneCounts[i])) {
+            for (size_t k = 0; k < i; k++) {
+                releaseSlots(m_lanes[k], laneCounts[k]);
+            }
+            for (const auto& event : events) {
+                noteDropped(pack(event), false);
+            }
+            return false;
+        }
+    }
+
+    for (const auto& event : events) {
+        enqueueReserved(laneFor(event.type), pack(event));
+    }
+
+    xSemaphoreGive(m_wakeup);
+    updatePriorityBoost(0);
+    return true;
 }
 
 bool FreeRtosEventBus::publishFromISR(const Event& event) {
-    if (!m_queue) {
+    if (!laneFor(event.type).queue) {
         return false;
     }
 
-    Event timestampedEvent = event;
-    if (timestampedEvent.timestamp == 0) {
-        timestampedEvent.timestamp = esp_timer_get_time();
+    PackedEvent packed = packEvent(event);
+    if (event.timestamp == 0) {
+        packed.timestamp = static_cast<uint32_t>(esp_timer_get_time());
     }
+    retainPayload(packed);
 
     BaseType_t xHigherPriorityTaskWoken = pdFALSE;
-    BaseType_t result = xQueueSendFromISR(m_queue, &timestampedEvent, &xHigherPriorityTaskWoken);
+    bool queued = enqueue(packed, &xHigherPriorityTaskWoken);
+    if (queued) {
+        xSemaphoreGiveFromISR(m_wakeup, &xHigherPriorityTaskWoken);
+    }
 
     if (xHigherPriorityTaskWoken == pdTRUE) {
         portYIELD_FROM_ISR(xHigherPriorityTaskWoken);
     }
 
-    return result == pdTRUE;
+    return queued;
 }
 
 void FreeRtosEventBus::processAllPending() {
-    Event event;
-    while (xQueueReceive(m_queue, &event, 0) == pdTRUE) {
-        dispatchEvent(event);
+    PackedEvent batch[EVENT_LOOP_BATCH_SIZE];
+    size_t count;
+    while ((count = receiveBatch(batch, EVENT_LOOP_BATCH_SIZE, 0)) > 0) {
+        dispatchBatch(batch, count);
     }
 }
 
 bool FreeRtosEventBus::waitForEvent(Event& outEvent, uint32_t timeoutMs) {
-    if (!m_queue) {
+    if (!m_wakeup) {
         return false;
     }
 
     TickType_t ticks = (timeoutMs == portMAX_DELAY) ? portMAX_DELAY : pdMS_TO_TICKS(timeoutMs);
-    if (xQueueReceive(m_queue, &outEvent, ticks) == pdTRUE) {
+    PackedEvent packed;
+    if (receiveBatch(&packed, 1, ticks) == 0) {
+        return false;
+    }
+
+    // A coalesced event expands to up to two levels; report the last one
+    PackedEvent levels[2] = {packed};
+    size_t count = (packed.flags & PACKED_EVENT_COALESCED) ? takeLevels(packed, levels) : 1;
+    uint64_t now = esp_timer_get_time();
+    const bool inlineOwner = beginDispatch();
+    for (size_t i = 0; i < count; i++) {
+        noteDispatched(levels[i], now);
+        outEvent = unpackEvent(levels[i], now);
         dispatchEvent(outEvent);
-        return true;
+        drainInline(nullptr);
     }
+    endDispatch(inlineOwner);
+    return true;
+}
 
-    return false;
+size_t FreeRtosEventBus::queueCapacity(EventPriority priority) const {
+    return m_lanes[static_cast<size_t>(priority)].size;
 }
 
-void FreeRtosEventBus::dispatchEvent(const Event& event) {
+FreeRtosEventBus::Lane& FreeRtosEventBus::laneFor(EventType type) {
+    return m_lanes[static_cast<size_t>(eventPriority(type))];
+}
+
+void FreeRtosEventBus::setOverflowPolicy(OverflowPolicy policy) {
+    for (auto& typePolicy : m_overflowPolicies) {
+        typePolicy.store(policy, std::memory_order_relaxed);
+    }
+}
+
+void FreeRtosEventBus::setOverflowPolicy(EventType type, OverflowPolicy policy) {
+    m_overflowPolicies[eventTypeIndex(type)].store(policy, std::memory_order_relaxed);
+}
+
+OverflowPolicy FreeRtosEventBus::getOverflowPolicy(EventType type) const {
+    return m_overflowPolicies[eventTypeIndex(type)].load(std::memory_order_relaxed);
+}
+
+void FreeRtosEventBus::setBlockTimeout(uint32_t timeoutMs) {
+    m_blockTicks.store(pdMS_TO_TICKS(timeoutMs), std::memory_order_relaxed);
+}
+
+IsrEventRing* FreeRtosEventBus::createIsrEventRing(EventType lowLevelEvent, EventType highLevelEvent, uint8_t source) {
+    size_t index = m_isrRingCount.load(std::memory_order_relaxed);
+    if (index >= MAX_ISR_SOURCES || !m_wakeup) {
+        ESP_LOGE(TAG, "Cannot create ISR event ring (%u in use)", (unsigned) index);
+        return nullptr;
+    }
+
+    m_isrRings[index] = std::make_unique<IsrEventRing>(lowLevelEvent, highLevelEvent, m_wakeup, source);
+    m_isrRingCount.store(index + 1, std::memory_order_release);
+    ESP_LOGI(TAG, "ISR event ring created (%s/%s)",
+             eventTypeToString(lowLevelEvent), eventTypeToString(highLevelEvent));
+    return m_isrRings[index].get();
+}
+
+EventTraceRecorder& FreeRtosEventBus::getTraceRecorder() {
+    return m_trace;
+}
+
+void FreeRtosEventBus::setCoalescing(bool enabled) {
+    m_coalescing = enabled;
+}
+
+bool FreeRtosEventBus::isCoalescing() const {
+    return m_coalescing;
+}
+
+EventBusStats FreeRtosEventBus::getStats() const {
+    EventBusStats stats;
+    for (size_t i = 0; i < EVENT_TYPE_COUNT; i++) {
+        const TypeCounters& counters = m_typeCounters[i];
+        stats.types[i].published = counters.published.load(std::memory_order_relaxed);
+        stats.types[i].dropped = counters.dropped.load(std::memory_order_relaxed);
+        stats.types[i].coalesced = counters.coalesced.load(std::memory_order_relaxed);
+        stats.types[i].inlined = counters.inlined.load(std::memory_order_relaxed);
+        stats.types[i].queued = counters.queued.load(std::memory_order_relaxed);
+        stats.types[i].highWatermark = counters.highWatermark.load(std::memory_order_relaxed);
+    }
+    for (size_t i = 0; i < EVENT_PRIORITY_COUNT; i++) {
+        stats.lanes[i].capacity = m_lanes[i].size;
+        stats.lanes[i].queued = m_lanes[i].reservedSlots.load(std::memory_order_relaxed);
+        stats.lanes[i].highWatermark = m_lanes[i].highWatermark.load(std::memory_order_relaxed);
+    }
+    stats.boost.active = m_boosted.load(std::memory_order_acquire);
+    stats.boost.boosts = m_boostCount.load(std::memory_order_relaxed);
+    stats.boost.boostedUs = m_boostedUs.load(std::memory_order_relaxed);
+    if (stats.boost.active) {
+        stats.boost.boostedUs += esp_timer_get_time() - m_boostStartUs.load(std::memory_order_relaxed);
+    }
+    return stats;
+}
+
+void FreeRtosEventBus::resetStats() {
+    for (TypeCounters& counters : m_typeCounters) {
+        counters.published.store(0, std::memory_order_relaxed);
+        counters.dropped.store(0, std::memory_order_relaxed);
+        counters.coalesced.store(0, std::memory_order_relaxed);
+        counters.inlined.store(0, std::memory_order_relaxed);
+        counters.highWatermark.store(counters.queued.load(std::memory_order_relaxed), std::memory_order_relaxed);
+    }
+    for (Lane& lane : m_lanes) {
+        lane.highWatermark.store(lane.reservedSlots.load(std::memory_order_relaxed), std::memory_order_relaxed);
+    }
+    for (LatencyHistogram& histogram : m_latency) {
+        histogram.reset();
+    }
     if (xSemaphoreTake(m_mutex, portMAX_DELAY) == pdTRUE) {
-        auto it = m_subscribers.find(event.type);
-        if (it != m_subscribers.end()) {
-            ESP_LOGD(TAG, "Dispatching event: %s to %d subscribers",
-                     eventTypeToString(event.type), it->second.size());
-
-            for (const auto& handler : it->second) {
-                if (handler) {
-                    handler(event);
-                }
+        for (auto& profile : m_profiles) {
+            profile->reset();
+        }
+        for (auto& worker : m_workers) {
+            worker->resetStats();
+        }
+        xSemaphoreGive(m_mutex);
+    }
+    m_budgetOverruns.store(0, std::memory_order_relaxed);
+    if (xSemaphoreTake(m_boostLock, portMAX_DELAY) == pdTRUE) {
+        m_boostCount.store(0, std::memory_order_relaxed);
+        m_boostedUs.store(0, std::memory_order_relaxed);
+        m_boostStartUs.store(esp_timer_get_time(), std::memory_order_relaxed); // A running boost counts from now
+        xSemaphoreGive(m_boostLock);
+    }
+}
+
+std::vector<HandlerStats> FreeRtosEventBus::getHandlerStats() const {
+    std::vector<HandlerStats> stats;
+    if (xSemaphoreTake(m_mutex, portMAX_DELAY) == pdTRUE) {
+        stats.reserve(m_profiles.size());
+        for (const auto& profile : m_profiles) {
+            stats.push_back(profile->getStats());
+        }
+        xSemaphoreGive(m_mutex);
+    }
+    return stats;
+}
+
+uint32_t FreeRtosEventBus::getBudgetOverruns() const {
+    return m_budgetOverruns.load(std::memory_order_relaxed);
+}
+
+LatencyStats FreeRtosEventBus::getLatencyStats(EventType type) const {
+    return m_latency[eventTypeIndex(type)].getStats();
+}
+
+const LatencyHistogram& FreeRtosEventBus::getLatencyHistogram(EventType type) const {
+    return m_latency[eventTypeIndex(type)];
+}
+
+bool FreeRtosEventBus::reserveSlots(Lane& lane, size_t count) {
+    // Lock-free and ISR-safe: CAS on the number of queued + in-flight events
+    size_t reserved = lane.reservedSlots.load(std::memory_order_relaxed);
+    do {
+        if (reserved + count > lane.size) {
+            return false;
+        }
+    } while (!lane.reservedSlots.compare_exchange_weak(reserved, reserved + count,
+                                                       std::memory_order_acq_rel,
+                                                       std::memory_order_relaxed));
+    updateMax(lane.highWatermark, reserved + count);
+    return true;
+}
+
+void FreeRtosEventBus::releaseSlots(Lane& lane, size_t count) {
+    lane.reservedSlots.fetch_sub(count, std::memory_order_acq_rel);
+}
+
+bool FreeRtosEventBus::enqueue(const PackedEvent& event, BaseType_t* isrTaskWoken) {
+    notePublished(event);
+
+    LevelCell* cell = levelCell(event);
+    if (!m_coalescing || !cell) {
+        return enqueueToLane(event, isrTaskWoken);
+    }
+
+    if (mergeLevel(*cell, event)) {
+        return true;
+    }
+
+    // First level of a run: queue a token that claims the source's level cell
+    PackedEvent token = event;
+    token.flags |= PACKED_EVENT_COALESCED;
+    if (!enqueueToLane(token, isrTaskWoken)) {
+        cancelLevel(*cell, isrTaskWoken != nullptr);
+        return false;
+    }
+    return true;
+}
+
+bool FreeRtosEventBus::enqueueToLane(const PackedEvent& packed, BaseType_t* isrTaskWoken) {
+    const bool fromISR = isrTaskWoken != nullptr;
+    const OverflowPolicy policy = m_overflowPolicies[packed.type].load(std::memory_order_relaxed);
+    Lane& lane = laneFor(static_cast<EventType>(packed.type));
+
+    // While an event of this type is parked, newer ones replace it instead of
+    // overtaking it through the queue
+    if (policy == OverflowPolicy::OverwriteLatest &&
+        (m_parkedMask.load(std::memory_order_relaxed) & (1u << packed.type)) != 0) {
+        park(packed);
+        return true;
+    }
+
+    if (!reserveSlots(lane, 1)) {
+        bool haveSlot = false;
+        switch (policy) {
+            case OverflowPolicy::DropNewest:
+                break;
+            case OverflowPolicy::DropOldest:
+                haveSlot = evictOldest(lane, isrTaskWoken);
+                break;
+            case OverflowPolicy::BlockWithTimeout:
+                haveSlot = !fromISR && waitForSlot(lane);
+                break;
+            case OverflowPolicy::OverwriteLatest:
+                park(packed);
+                return true;
+        }
+        if (!haveSlot) {
+            noteDropped(packed, fromISR);
+            return false;
+        }
+    }
+
+    BaseType_t sent = fromISR ? xQueueSendFromISR(lane.queue, &packed, isrTaskWoken)
+                              : xQueueSend(lane.queue, &packed, 0);
+    if (sent != pdTRUE) {
+        // Cannot happen while all producers reserve slots first
+        releaseSlots(lane, 1);
+        noteDropped(packed, fromISR);
+        return false;
+    }
+
+    noteQueued(packed.type);
+    return true;
+}
+
+bool FreeRtosEventBus::sendToLane(Lane& lane, const PackedEvent& packed) {
+    if (xQueueSend(lane.queue, &packed, 0) != pdTRUE) {
+        // Cannot happen while all producers reserve slots first
+        releaseSlots(lane, 1);
+        noteDropped(packed, false);
+        return false;
+    }
+    noteQueued(packed.type);
+    return true;
+}
+
+void FreeRtosEventBus::enqueueReserved(Lane& lane, const PackedEvent& packed) {
+    // Same ordering rules as enqueue(); an event that is parked or merged hands its slot back
+    const OverflowPolicy policy = m_overflowPolicies[packed.type].load(std::memory_order_relaxed);
+    if (policy == OverflowPolicy::OverwriteLatest &&
+        (m_parkedMask.load(std::memory_order_relaxed) & (1u << packed.type)) != 0) {
+        releaseSlots(lane, 1);
+        park(packed);
+        return;
+    }
+
+    LevelCell* cell = m_coalescing ? levelCell(packed) : nullptr;
+    if (!cell) {
+        (void) sendToLane(lane, packed);
+        return;
+    }
+    if (mergeLevel(*cell, packed)) {
+        releaseSlots(lane, 1);
+        return;
+    }
+    PackedEvent token = packed;
+    token.flags |= PACKED_EVENT_COALESCED;
+    if (!sendToLane(lane, token)) {
+        cancelLevel(*cell, false);
+    }
+}
+
+bool FreeRtosEventBus::evictOldest(Lane& lane, BaseType_t* isrTaskWoken) {
+    PackedEvent oldest;
+    BaseType_t received = isrTaskWoken ? xQueueReceiveFromISR(lane.queue, &oldest, isrTaskWoken)
+                                       : xQueueReceive(lane.queue, &oldest, 0);
+    if (received != pdTRUE) {
+        // Lane drained in the meantime (or all slots are still being sent)
+        return reserveSlots(lane, 1);
+    }
+
+    // The evicted event's slot is handed over to the new event
+    m_typeCounters[oldest.type].queued.fetch_sub(1, std::memory_order_relaxed);
+    PackedEvent levels[2] = {oldest};
+    size_t count = (oldest.flags & PACKED_EVENT_COALESCED) ? takeLevels(oldest, levels) : 1;
+    for (size_t i = 0; i < count; i++) {
+        noteDropped(levels[i], isrTaskWoken != nullptr);
+    }
+    return true;
+}
+
+bool FreeRtosEventBus::waitForSlot(Lane& lane) {
+    // Never block the only task that can free a slot
+    if (m_eventLoopTask != nullptr && xTaskGetCurrentTaskHandle() == m_eventLoopTask) {
+        return false;
+    }
+
+    if (!lane.slotFreed) {
+        return false;
+    }
+
+    // Registered before the first attempt, so a consumer draining the lane right after it sees the waiter
+    lane.slotWaiters.fetch_add(1, std::memory_order_seq_cst);
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+
+    const TickType_t blockTicks = m_blockTicks.load(std::memory_order_relaxed);
+    const TickType_t start = xTaskGetTickCount();
+    bool reserved = reserveSlots(lane, 1);
+    while (!reserved) {
+        const TickType_t waited = xTaskGetTickCount() - start;
+        if (waited >= blockTicks || xSemaphoreTake(lane.slotFreed, blockTicks - waited) != pdTRUE) {
+            break;
+        }
+        reserved = reserveSlots(lane, 1);
+    }
+
+    // A drained batch frees several slots, but the signal wakes one waiter: pass it on
+    if (lane.slotWaiters.fetch_sub(1, std::memory_order_seq_cst) > 1 && reserved) {
+        xSemaphoreGive(lane.slotFreed);
+    }
+    return reserved;
+}
+
+void FreeRtosEventBus::notifySlotsFreed(Lane& lane) {
+    // Pairs with the fence in waitForSlot(): either the waiter sees the freed slots or we see the waiter
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    if (lane.slotWaiters.load(std::memory_order_relaxed) > 0) {
+        xSemaphoreGive(lane.slotFreed);
+    }
+}
+
+void FreeRtosEventBus::park(const PackedEvent& packed) {
+    const uint32_t bit = 1u << packed.type;
+
+    portENTER_CRITICAL_SAFE(&m_parkedLock);
+    bool replaced = (m_parkedMask.load(std::memory_order_relaxed) & bit) != 0;
+    PackedEvent overwritten = m_parked[packed.type];
+    m_parked[packed.type] = packed;
+    m_parkedMask.fetch_or(bit, std::memory_order_release);
+    portEXIT_CRITICAL_SAFE(&m_parkedLock);
+
+    if (replaced) {
+        // Overwritten event is lost, the queued count stays the same
+        m_typeCounters[packed.type].dropped.fetch_add(1, std::memory_order_relaxed);
+        releasePayload(overwritten);
+    } else {
+        noteQueued(packed.type);
+    }
+}
+
+size_t FreeRtosEventBus::takeParked(EventPriority priority, PackedEvent* batch, size_t maxCount) {
+    const uint32_t laneMask = laneTypeMask(priority);
+    if (maxCount == 0 || (m_parkedMask.load(std::memory_order_acquire) & laneMask) == 0) {
+        return 0;
+    }
+
+    size_t count = 0;
+    portENTER_CRITICAL_SAFE(&m_parkedLock);
+    uint32_t pending = m_parkedMask.load(std::memory_order_relaxed) & laneMask;
+    while (pending != 0 && count < maxCount) {
+        const int index = std::countr_zero(pending);
+        pending &= pending - 1;
+        batch[count++] = m_parked[index];
+        m_parkedMask.fetch_and(~(1u << index), std::memory_order_relaxed);
+    }
+    portEXIT_CRITICAL_SAFE(&m_parkedLock);
+
+    return count;
+}
+
+FreeRtosEventBus::LevelCell* FreeRtosEventBus::levelCell(const PackedEvent& packed) {
+    // Cells per level source and lane, so flicker on one lane never merges into another
+    // Pooled payloads are never merged: a replaced level would keep its block referenced
+    const size_t source = levelSourceIndex(static_cast<EventType>(packed.type));
+    if (source == NO_LEVEL_SOURCE || packed.source >= MAX_EVENT_SOURCES ||
+        packed.payloadTag == static_cast<uint8_t>(PayloadTag::Pooled)) {
+        return nullptr;
+    }
+    return &m_levelCells[packed.source * LEVEL_SOURCE_COUNT + source];
+}
+
+bool FreeRtosEventBus::mergeLevel(LevelCell& cell, const PackedEvent& packed) {
+    portENTER_CRITICAL_SAFE(&m_levelLock);
+    bool merged = cell.pending;
+    if (merged) {
+        cell.last = packed;
+        cell.hasLast = true;
+    } else {
+        cell.pending = true; // Caller queues the token
+        cell.hasLast = false;
+    }
+    portEXIT_CRITICAL_SAFE(&m_levelLock);
+
+    if (merged) {
+        m_typeCounters[packed.type].coalesced.fetch_add(1, std::memory_order_relaxed);
+    }
+    return merged;
+}
+
+void FreeRtosEventBus::cancelLevel(LevelCell& cell, bool fromISR) {
+    portENTER_CRITICAL_SAFE(&m_levelLock);
+    PackedEvent last = cell.last;
+    bool hasLast = cell.hasLast;
+    cell.pending = false;
+    cell.hasLast = false;
+    portEXIT_CRITICAL_SAFE(&m_levelLock);
+
+    // Levels merged while the token was being sent are lost with it
+    if (hasLast) {
+        noteDropped(last, fromISR);
+    }
+}
+
+size_t FreeRtosEventBus::takeLevels(const PackedEvent& token, PackedEvent* levels) {
+    LevelCell& cell = *levelCell(token); // Only coalescable events become tokens
+
+    portENTER_CRITICAL_SAFE(&m_levelLock);
+    PackedEvent last = cell.last;
+    bool hasLast = cell.hasLast;
+    cell.pending = false;
+    cell.hasLast = false;
+    portEXIT_CRITICAL_SAFE(&m_levelLock);
+
+    levels[0] = token;
+    levels[0].flags &= ~PACKED_EVENT_COALESCED;
+
+    // Same level as the token: the run ended where it started
+    if (!hasLast || last.type == token.type) {
+        return 1;
+    }
+    levels[1] = last;
+    return 2;
+}
+
+void FreeRtosEventBus::noteQueued(uint8_t type) {
+    TypeCounters& counters = m_typeCounters[type];
+    updateMax(counters.highWatermark, counters.queued.fetch_add(1, std::memory_order_relaxed) + 1);
+}
+
+void FreeRtosEventBus::notePublished(const PackedEvent& packed) {
+    m_typeCounters[packed.type].published.fetch_add(1, std::memory_order_relaxed);
+    m_trace.record(TraceKind::Published, packed);
+}
+
+void FreeRtosEventBus::noteDropped(const PackedEvent& packed, bool fromISR) {
+    uint32_t previous = m_typeCounters[packed.type].dropped.fetch_add(1, std::memory_order_relaxed);
+    m_trace.record(TraceKind::Dropped, packed);
+    releasePayload(packed); // The dropped queue item's reference ends here
+
+    // Log the first drop only: UART output is slowest exactly when the bus is overloaded
+    if (previous == 0 && !fromISR) {
+        ESP_LOGW(TAG, "Event queue full, dropping %s (further drops are only counted)",
+                 eventTypeToString(static_cast<EventType>(packed.type)));
+    }
+}
+
+void FreeRtosEventBus::noteDispatched(const PackedEvent& packed, uint64_t now) {
+    m_trace.record(TraceKind::Dispatched, packed, static_cast<uint32_t>(now));
+
+    // Signed 32-bit distance survives timestamp wrap-around; future timestamps count as 0
+    auto latency = static_cast<int32_t>(static_cast<uint32_t>(now) - packed.timestamp);
+    m_latency[packed.type].record(latency > 0 ? static_cast<uint32_t>(latency) : 0);
+}
+
+size_t FreeRtosEventBus::drainIsrRings(PackedEvent* batch, size_t maxCount) {
+    size_t count = 0;
+    const size_t ringCount = m_isrRingCount.load(std::memory_order_acquire);
+
+    for (size_t i = 0; i < ringCount; i++) {
+        IsrEventRing& ring = *m_isrRings[i];
+        for (bool level : {false, true}) {
+            // Overruns are only counted in the ISR; their edge times are lost
+            PackedEvent lost{};
+            lost.type = static_cast<uint8_t>(ring.eventFor(level));
+            lost.source = ring.source();
+            for (uint32_t dropped = ring.takeDropped(level); dropped > 0; dropped--) {
+                notePublished(lost);
+                noteDropped(lost, false);
             }
         }
+
+        // Only level sources coalesce: every button press must reach the controller
+        const bool levelRing = levelSourceIndex(ring.eventFor(false)) != NO_LEVEL_SOURCE &&
+                               levelSourceIndex(ring.eventFor(true)) != NO_LEVEL_SOURCE;
+        if (!m_coalescing || !levelRing) {
+            while (count < maxCount && ring.pop(batch[count])) {
+                notePublished(batch[count]);
+                count++;
+            }
+            continue;
+        }
+
+        // Coalesced: the run becomes its first level plus the latest one if
+        // different. With a single free slot the rest of the run stays queued.
+        PackedEvent first;
+        if (count == maxCount || !ring.pop(first)) {
+            continue;
+        }
+        notePublished(first);
+        if (maxCount - count == 1) {
+            batch[count++] = first;
+            continue;
+        }
+
+        PackedEvent last = first;
+        PackedEvent edge;
+        bool hasLast = false;
+        while (ring.pop(edge)) {
+            notePublished(edge);
+            if (hasLast) {
+                m_typeCounters[last.type].coalesced.fetch_add(1, std::memory_order_relaxed);
+            }
+            last = edge;
+            hasLast = true;
+        }
+
+        batch[count++] = first;
+        if (hasLast && last.type != first.type) {
+            batch[count++] = last;
+        } else if (hasLast) {
+            m_typeCounters[last.type].coalesced.fetch_add(1, std::memory_order_relaxed);
+        }
+    }
+
+    return count;
+}
+
+size_t FreeRtosEventBus::takeAvailable(PackedEvent* batch, size_t maxCount) {
+    // Interrupt edges are the most time critical and go ahead of both lanes
+    size_t count = drainIsrRings(batch, maxCount);
+    const size_t ringEvents = count;
+
+    // Lanes are ordered by priority: the high lane is always emptied first.
+    // Parked events of a lane are newer than its queued ones and go last.
+    for (size_t i = 0; i < EVENT_PRIORITY_COUNT; i++) {
+        Lane& lane = m_lanes[i];
+        if (!lane.queue) {
+            continue;
+        }
+        size_t taken = 0;
+        while (count < maxCount && xQueueReceive(lane.queue, &batch[count], 0) == pdTRUE) {
+            count++;
+            taken++;
+        }
+        if (taken > 0) {
+            releaseSlots(lane, taken);
+            notifySlotsFreed(lane);
+        }
+        count += takeParked(static_cast<EventPriority>(i), &batch[count], maxCount - count);
+    }
+
+    for (size_t i = ringEvents; i < count; i++) {
+        m_typeCounters[batch[i].type].queued.fetch_sub(1, std::memory_order_relaxed);
+    }
+
+    return count;
+}
+
+size_t FreeRtosEventBus::receiveBatch(PackedEvent* batch, size_t maxCount, TickType_t ticks) {
+    if (!m_wakeup || maxCount == 0) {
+        return 0;
+    }
+
+    size_t count = takeAvailable(batch, maxCount);
+
+    // Block on the wakeup signal only when both lanes are empty. A signal can be
+    // left over from events an earlier call already drained, so wait once more
+    // if the first wakeup finds nothing - unless it was a stop request.
+    for (int attempt = 0; count == 0 && ticks != 0 && attempt < 2 &&
+                          !m_stopRequested.load(std::memory_order_acquire);
+         attempt++) {
+        if (xSemaphoreTake(m_wakeup, ticks) != pdTRUE) {
+            break;
+        }
+        count = takeAvailable(batch, maxCount);
+    }
+
+    // Backlog left after taking the batch decides whether a boost ends
+    updatePriorityBoost(portMAX_DELAY);
+    return count;
+}
+
+void FreeRtosEventBus::dispatchBatch(const PackedEvent* batch, size_t count) {
+    const bool inlineOwner = beginDispatch();
+    // One table read for the whole batch
+    std::atomic<uint32_t>& readers = tableReaders();
+    if (const EventDispatchTable* table = acquireTable(readers)) {
+        for (size_t i = 0; i < count; i++) {
+            dispatchPacked(*table, batch[i]);
+        }
+        releaseTable(readers);
+    }
+    endDispatch(inlineOwner);
+
+    ESP_LOGD(TAG, "Dispatched batch of %u events", (unsigned) count);
+}
+
+void FreeRtosEventBus::dispatchPacked(const EventDispatchTable& table, const PackedEvent& packed) {
+    // Per event rather than per batch: latency ends when the event's first handler starts
+    uint64_t now = esp_timer_get_time();
+    if ((packed.flags & PACKED_EVENT_COALESCED) == 0) {
+        noteDispatched(packed, now);
+        dispatchToTable(table, unpackEvent(packed, now));
+    } else {
+        PackedEvent levels[2];
+        size_t count = takeLevels(packed, levels);
+        for (size_t i = 0; i < count; i++) {
+            noteDispatched(levels[i], now);
+            dispatchToTable(table, unpackEvent(levels[i], now));
+        }
+    }
+    drainInline(&table);
+}
+
+void FreeRtosEventBus::setInlineDispatch(bool enabled) {
+    m_inlineDispatch = enabled;
+}
+
+bool FreeRtosEventBus::isInlineDispatch() const {
+    return m_inlineDispatch;
+}
+
+bool FreeRtosEventBus::beginDispatch() {
+    // First dispatching task owns the inline FIFO; concurrent dispatches on other tasks queue as usual
+    TaskHandle_t expected = nullptr;
+    return m_inlineOwner.compare_exchange_strong(expected, xTaskGetCurrentTaskHandle(), std::memory_order_acquire,
+                                                 std::memory_order_relaxed);
+}
+
+void FreeRtosEventBus::endDispatch(bool inlineOwner) {
+    if (inlineOwner) {
+        m_inlineOwner.store(nullptr, std::memory_order_release);
+    }
+}
+
+bool FreeRtosEventBus::ownsInlineFifo() const {
+    return m_inlineOwner.load(std::memory_order_relaxed) == xTaskGetCurrentTaskHandle();
+}
+
+bool FreeRtosEventBus::canPublishInline(size_t count) const {
+    // Only publishes from a handler on the task owning the FIFO
+    return m_inlineDispatch && ownsInlineFifo() && m_inlineCount + count <= INLINE_FIFO_SIZE;
+}
+
+bool FreeRtosEventBus::publishInline(const PackedEvent& packed) {
+    if (!canPublishInline(1)) {
+        return false;
+    }
+
+    m_inlineFifo[(m_inlineHead + m_inlineCount) % INLINE_FIFO_SIZE] = packed;
+    m_inlineCount++;
+    notePublished(packed);
+    m_typeCounters[packed.type].inlined.fetch_add(1, std::memory_order_relaxed);
+    return true;
+}
+
+void FreeRtosEventBus::drainInline(const EventDispatchTable* table) {
+    // Handlers of inline events may publish again: those are appended and drained in the same loop
+    while (ownsInlineFifo() && m_inlineCount > 0) {
+        PackedEvent packed = m_inlineFifo[m_inlineHead];
+        m_inlineHead = (m_inlineHead + 1) % INLINE_FIFO_SIZE;
+        m_inlineCount--;
+
+        uint64_t now = esp_timer_get_time();
+        noteDispatched(packed, now);
+        if (table) {
+            dispatchToTable(*table, unpackEvent(packed, now));
+        } else {
+            dispatchEvent(unpackEvent(packed, now));
+        }
+    }
+}
+
+void FreeRtosEventBus::seal() {
+    if (xSemaphoreTake(m_mutex, portMAX_DELAY) == pdTRUE) {
+        m_sealed.store(true, std::memory_order_release);
         xSemaphoreGive(m_mutex);
+        ESP_LOGI(TAG, "Subscriber table sealed (lock-free dispatch)");
+    }
+}
+
+bool FreeRtosEventBus::isSealed() const {
+    return m_sealed.load(std::memory_order_acquire);
+}
+
+void FreeRtosEventBus::dispatchEvent(const Event& event) {
+    std::atomic<uint32_t>& readers = tableReaders();
+    if (const EventDispatchTable* table = acquireTable(readers)) {
+        dispatchToTable(*table, event);
+        releaseTable(readers);
+    }
+}
+
+void FreeRtosEventBus::dispatchToTable(const EventDispatchTable& table, const Event& event) {
+    HandlerProfile* overrun = nullptr;
+    size_t handlerCount = table.dispatch(event, &overrun);
+    ESP_LOGD(TAG, "Dispatched event: %s to %u subscribers", eventTypeToString(event.type), (unsigned) handlerCount);
+
+    if (overrun) {
+        m_budgetOverruns.fetch_add(1, std::memory_order_relaxed);
+
+        // Warn once per handler, the overrun counters keep the rest
+        if (overrun->overruns.load(std::memory_order_relaxed) == 1) {
+            ESP_LOGW(TAG, "Handler %s for %s exceeded its budget of %u us (max %u us)",
+                     overrun->options.name ? overrun->options.name : "unnamed", eventTypeToString(event.type),
+                     (unsigned) overrun->options.budgetUs, (unsigned) overrun->maxUs.load(std::memory_order_relaxed));
+        }
     }
 }
 
 void FreeRtosEventBus::startEventLoop(uint32_t stackSize, UBaseType_t priority,
-                                      const char* taskName) {
+                                      const char* taskName, BaseType_t core) {
+    startLoopTask(eventLoopTask, this, stackSize, priority, taskName, core);
+}
+
+void FreeRtosEventBus::startLoopTask(TaskFunction_t task, void* context, uint32_t stackSize,
+                                     UBaseType_t priority, const char* taskName, BaseType_t core) {
     if (m_eventLoopTask != nullptr) {
         ESP_LOGW(TAG, "Event loop already running");
         return;
     }
 
-    m_stopRequested = false;
+    m_stopRequested.store(false, std::memory_order_release);
+    (void) xSemaphoreTake(m_loopExited, 0); // Clear exit signal of a previous run
+    m_loopPriority = priority;
 
-    BaseType_t result = xTaskCreate(
-        eventLoopTask,
+    BaseType_t result = xTaskCreatePinnedToCore(
+        task,
         taskName,
         stackSize,
-        this,
+        context,
         priority,
-        &m_eventLoopTask);
+        &m_eventLoopTask,
+        core);
 
     if (result == pdPASS) {
-        ESP_LOGI(TAG, "Event loop task started (stack: %lu, priority: %u)",
-                 stackSize, priority);
+        ESP_LOGI(TAG, "%s task started (stack: %lu, priority: %u)",
+                 taskName, stackSize, priority);
+        if (xSemaphoreTake(m_mutex, portMAX_DELAY) == pdTRUE) {
+            for (auto& worker : m_workers) {
+                worker->start();
+            }
+            xSemaphoreGive(m_mutex);
+        }
     } else {
         ESP_LOGE(TAG, "Failed to create event loop task");
         m_eventLoopTask = nullptr;
@@ -146,22 +1187,49 @@ void FreeRtosEventBus::stopEventLoop() {
     }
 
     ESP_LOGI(TAG, "Stopping event loop...");
-    m_stopRequested = true;
+    m_stopRequested.store(true, std::memory_order_release);
+    xSemaphoreGive(m_wakeup);
 
-    // Give the task time to exit gracefully
-    vTaskDelay(pdMS_TO_TICKS(100));
+    if (xTaskGetCurrentTaskHandle() == m_eventLoopTask) {
+        // Called from a handler: the loop exits after the current batch and
+        // the next stopEventLoop() call completes the join
+        ESP_LOGW(TAG, "Event loop stop requested from its own task");
+        return;
+    }
 
-    // If still running, delete it
-    if (m_eventLoopTask != nullptr) {
+    // Join: the task signals right before deleting itself
+    if (xSemaphoreTake(m_loopExited, pdMS_TO_TICKS(STOP_TIMEOUT_MS)) != pdTRUE) {
+        ESP_LOGE(TAG, "Event loop did not exit within %u ms, deleting task", (unsigned) STOP_TIMEOUT_MS);
         vTaskDelete(m_eventLoopTask);
-        m_eventLoopTask = nullptr;
+        TaskHandle_t deleted = m_eventLoopTask;
+        if (m_inlineOwner.load(std::memory_order_acquire) == deleted) {
+            // Cascade of the deleted task is lost; free the FIFO for other dispatchers
+            for (; m_inlineCount > 0; m_inlineCount--) {
+                releasePayload(m_inlineFifo[m_inlineHead]);
+                m_inlineHead = (m_inlineHead + 1) % INLINE_FIFO_SIZE;
+            }
+            m_inlineOwner.store(nullptr, std::memory_order_release);
+        }
+        // Its table reads never end: without this every later subscription would copy the table
+        m_loopReaders.store(0, std::memory_order_release);
+    }
+    endPriorityBoost();
+    m_eventLoopTask = nullptr;
+    m_stopRequested.store(false, std::memory_order_release); // Direct receives may block again
+
+    // No more forwarded events once the loop is gone
+    if (xSemaphoreTake(m_mutex, portMAX_DELAY) == pdTRUE) {
+        for (auto& worker : m_workers) {
+            worker->stop();
+        }
+        xSemaphoreGive(m_mutex);
     }
 
     ESP_LOGI(TAG, "Event loop stopped");
 }
 
 bool FreeRtosEventBus::isEventLoopRunning() const {
-    return m_eventLoopTask != nullptr && !m_stopRequested;
+    return m_eventLoopTask != nullptr && !m_stopRequested.load(std::memory_order_acquire);
 }
 
 void FreeRtosEventBus::eventLoopTask(void* pvParameters) {
@@ -169,15 +1237,110 @@ void FreeRtosEventBus::eventLoopTask(void* pvParameters) {
 
     ESP_LOGI(TAG, "Event loop task running");
 
-    Event event;
-    while (!self->m_stopRequested) {
-        // Wait for event with timeout to check stop flag periodically
-        if (self->waitForEvent(event, 100)) {
-            ESP_LOGD(TAG, "Event processed: %s", eventTypeToString(event.type));
+    PackedEvent batch[EVENT_LOOP_BATCH_SIZE];
+    while (!self->loopStopRequested()) {
+        // Block until a publisher, an ISR ring or stopEventLoop() signals -
+        // an idle bus causes no periodic wakeups
+        size_t count = self->receiveBatch(batch, EVENT_LOOP_BATCH_SIZE, portMAX_DELAY);
+        if (count > 0) {
+            self->dispatchBatch(batch, count);
         }
     }
 
     ESP_LOGI(TAG, "Event loop task exiting");
-    self->m_eventLoopTask = nullptr;
+
+    // Must be the last access to self: the bus may be destroyed once joined
+    self->signalLoopExited();
     vTaskDelete(nullptr);
 }
+
+bool FreeRtosEventBus::loopStopRequested() const {
+    return m_stopRequested.load(std::memory_order_acquire);
+}
+
+void FreeRtosEventBus::signalLoopExited() {
+    xSemaphoreGive(m_loopExited);
+}
+
+void FreeRtosEventBus::setPriorityBoost(const PriorityBoostConfig& config) {
+    // Hysteresis needs lowWater < highWater
+    size_t lowWater = config.highWater > 0 ? std::min(config.lowWater, config.highWater - 1) : 0;
+    m_boostLowWater.store(lowWater, std::memory_order_relaxed);
+    m_boostPriority.store(config.priority, std::memory_order_relaxed);
+    m_boostHighWater.store(config.highWater, std::memory_order_release);
+
+    if (config.highWater == 0) {
+        ESP_LOGI(TAG, "Event loop priority boost disabled");
+    } else {
+        ESP_LOGI(TAG, "Event loop priority boost: priority %u at %u queued events, restored at %u",
+                 (unsigned) config.priority, (unsigned) config.highWater, (unsigned) lowWater);
+    }
+
+    // Applies to a backlog that is already there, or ends a boost just disabled
+    updatePriorityBoost(portMAX_DELAY);
+}
+
+PriorityBoostConfig FreeRtosEventBus::getPriorityBoost() const {
+    return PriorityBoostConfig{.highWater = m_boostHighWater.load(std::memory_order_relaxed),
+                               .lowWater = m_boostLowWater.load(std::memory_order_relaxed),
+                               .priority = m_boostPriority.load(std::memory_order_relaxed)};
+}
+
+size_t FreeRtosEventBus::queuedEvents() const {
+    size_t queued = 0;
+    for (const Lane& lane : m_lanes) {
+        queued += lane.reservedSlots.load(std::memory_order_relaxed);
+    }
+    return queued;
+}
+
+void FreeRtosEventBus::updatePriorityBoost(TickType_t lockTicks) {
+    const size_t highWater = m_boostHighWater.load(std::memory_order_acquire);
+    const bool boosted = m_boosted.load(std::memory_order_acquire);
+    if ((highWater == 0 && !boosted) || m_eventLoopTask == nullptr) {
+        return;
+    }
+
+    const size_t queued = queuedEvents();
+    const UBaseType_t priority = m_boostPriority.load(std::memory_order_relaxed);
+    const bool change = boosted ? highWater == 0 || queued <= m_boostLowWater.load(std::memory_order_relaxed)
+                                : queued >= highWater && priority > m_loopPriority;
+    if (!change) {
+        return;
+    }
+
+    // Publishers pass 0 and never wait: a boost skipped while the consumer
+    // restores the priority is retried by the next publish
+    if (!m_boostLock || xSemaphoreTake(m_boostLock, lockTicks) != pdTRUE) {
+        return;
+    }
+    if (m_boosted.load(std::memory_order_relaxed) == boosted && m_eventLoopTask != nullptr) {
+        uint64_t now = esp_timer_get_time();
+        if (boosted) {
+            vTaskPrioritySet(m_eventLoopTask, m_loopPriority);
+            m_boostedUs.fetch_add(now - m_boostStartUs.load(std::memory_order_relaxed), std::memory_order_relaxed);
+            m_boosted.store(false, std::memory_order_release);
+            ESP_LOGD(TAG, "Event loop priority restored to %u (%u queued)", (unsigned) m_loopPriority,
+                     (unsigned) queued);
+        } else {
+            vTaskPrioritySet(m_eventLoopTask, priority);
+            m_boostStartUs.store(now, std::memory_order_relaxed);
+            m_boostCount.fetch_add(1, std::memory_order_relaxed);
+            m_boosted.store(true, std::memory_order_release);
+            ESP_LOGD(TAG, "Event loop priority boosted to %u (%u queued)", (unsigned) priority, (unsigned) queued);
+        }
+    }
+    xSemaphoreGive(m_boostLock);
+}
+
+void FreeRtosEventBus::endPriorityBoost() {
+    // Loop task is gone: only the time accounting is left to close
+    if (m_boostLock && xSemaphoreTake(m_boostLock, portMAX_DELAY) == pdTRUE) {
+        if (m_boosted.load(std::memory_order_relaxed)) {
+            m_boostedUs.fetch_add(esp_timer_get_time() - m_boostStartUs.load(std::memory_order_relaxed),
+                                  std::memory_order_relaxed);
+            m_boosted.store(false, std::memory_order_release);
+        }
+        xSemaphoreGive(m_boostLock);
+    }
+}
@@ -0,0 +1,63 @@
+#include "IsrEventRing.h"
+#include "esp_attr.h"
+
+IsrEventRing::IsrEventRing(EventType lowLevelEvent, EventType highLevelEvent, SemaphoreHandle_t wakeup,
+                           uint8_t source)
+    : m_lowLevelEvent(lowLevelEvent)
+    , m_highLevelEvent(highLevelEvent)
+    , m_wakeup(wakeup)
+    , m_source(source) {}
+
+bool IRAM_ATTR IsrEventRing::write(bool level, uint32_t timestamp) {
+    uint32_t head = m_head.load(std::memory_order_relaxed);
+    if (head - m_tail.load(std::memory_order_acquire) >= CAPACITY) {
+        m_dropped[level ? 1 : 0].fetch_add(1, std::memory_order_relaxed);
+        return false;
+    }
+
+    m_edges[head & (CAPACITY - 1)] = Edge{timestamp, level};
+    m_head.store(head + 1, std::memory_order_release);
+    return true;
+}
+
+bool IRAM_ATTR IsrEventRing::pushFromISR(bool level, uint32_t timestamp) {
+    if (!write(level, timestamp)) {
+        return false;
+    }
+
+    BaseType_t xHigherPriorityTaskWoken = pdFALSE;
+    xSemaphoreGiveFromISR(m_wakeup, &xHigherPriorityTaskWoken);
+    if (xHigherPriorityTaskWoken == pdTRUE) {
+        portYIELD_FROM_ISR(xHigherPriorityTaskWoken);
+    }
+    return true;
+}
+
+bool IsrEventRing::push(bool level, uint32_t timestamp) {
+    if (!write(level, timestamp)) {
+        return false;
+    }
+
+    xSemaphoreGive(m_wakeup);
+    return true;
+}
+
+bool IsrEventRing::pop(PackedEvent& outEvent) {
+    uint32_t tail = m_tail.load(std::memory_order_relaxed);
+    if (tail == m_head.load(std::memory_order_acquire)) {
+        return false;
+    }
+
+    const Edge edge = m_edges[tail & (CAPACITY - 1)];
+    m_tail.store(tail + 1, std::memory_order_release);
+
+    outEvent = PackedEvent{};
+    outEvent.type = static_cast<uint8_t>(eventFor(edge.level));
+    outEvent.timestamp = edge.timestamp;
+    outEvent.source = m_source;
+    return true;
+}
+
+uint32_t IsrEventRing::takeDropped(bool level) {
+    return m_dropped[level ? 1 : 0].exchange(0, std::memory_order_relaxed);
+}
@@ -0,0 +1,192 @@
+#include "PayloadPool.h"
+#include "esp_attr.h"
+#include "esp_log.h"
+#include <cstring>
+
+static const char* TAG = "PayloadPool";
+
+namespace {
+
+constexpr uint32_t EMPTY_INDEX = 0xFFFF;
+
+constexpr uint32_t handlePool(uint32_t handle) {
+    return handle >> 24;
+}
+
+constexpr uint32_t handleGeneration(uint32_t handle) {
+    return (handle >> 16) & 0xFF;
+}
+
+constexpr uint32_t handleIndex(uint32_t handle) {
+    return handle & 0xFFFF;
+}
+
+} // namespace
+
+std::array<std::atomic<PayloadPool*>, PayloadPool::MAX_POOLS> PayloadPool::s_pools{};
+
+PayloadPool::PayloadPool(size_t blockSize, size_t blockCount)
+    : m_blockSize(blockSize)
+    , m_blockCount(blockCount < MAX_BLOCKS ? blockCount : MAX_BLOCKS)
+    , m_stride((blockSize + sizeof(uint64_t) - 1) / sizeof(uint64_t)) {
+    m_storage = std::make_unique<uint64_t[]>(m_stride * m_blockCount);
+    m_blocks = std::make_unique<Block[]>(m_blockCount);
+
+    // Free list in index order, terminated by EMPTY_INDEX
+    for (size_t i = 0; i < m_blockCount; i++) {
+        m_blocks[i].next.store(i + 1 < m_blockCount ? i + 1 : EMPTY_INDEX, std::memory_order_relaxed);
+    }
+    m_freeHead.store(m_blockCount > 0 ? 0 : EMPTY_INDEX, std::memory_order_release);
+
+    for (size_t slot = 0; slot < MAX_POOLS; slot++) {
+        PayloadPool* expected = nullptr;
+        if (s_pools[slot].compare_exchange_strong(expected, this, std::memory_order_acq_rel)) {
+            m_id = slot + 1;
+            break;
+        }
+    }
+    if (m_id == 0) {
+        ESP_LOGE(TAG, "Pool limit reached (%u), allocations will fail", (unsigned) MAX_POOLS);
+        return;
+    }
+
+    ESP_LOGI(TAG, "Payload pool %lu created (%u blocks of %u bytes)", (unsigned long) m_id,
+             (unsigned) m_blockCount, (unsigned) m_blockSize);
+}
+
+PayloadPool::~PayloadPool() {
+    uint32_t inUse = m_inUse.load(std::memory_order_acquire);
+    if (inUse > 0) {
+        ESP_LOGW(TAG, "Payload pool %lu destroyed with %lu blocks referenced", (unsigned long) m_id,
+                 (unsigned long) inUse);
+    }
+    if (m_id != 0) {
+        s_pools[m_id - 1].store(nullptr, std::memory_order_release);
+    }
+}
+
+PayloadRef IRAM_ATTR PayloadPool::allocate(const void* data, size_t size) {
+    uint32_t index;
+    if (m_id == 0 || size > m_blockSize || !popFree(index)) {
+        m_failed.fetch_add(1, std::memory_order_relaxed);
+        return PayloadRef();
+    }
+
+    Block& block = m_blocks[index];
+    memcpy(&m_storage[index * m_stride], data, size);
+    block.size = size;
+    block.refs.store(1, std::memory_order_release);
+
+    uint32_t inUse = m_inUse.fetch_add(1, std::memory_order_relaxed) + 1;
+    uint32_t peak = m_highWatermark.load(std::memory_order_relaxed);
+    while (inUse > peak && !m_highWatermark.compare_exchange_weak(peak, inUse, std::memory_order_relaxed)) {
+    }
+
+    uint32_t generation = block.generation.load(std::memory_order_relaxed) & 0xFF;
+    return PayloadRef::adopt((m_id << 24) | (generation << 16) | index);
+}
+
+PayloadPoolStats PayloadPool::getStats() const {
+    PayloadPoolStats stats;
+    stats.blockSize = m_blockSize;
+    stats.blockCount = m_blockCount;
+    stats.inUse = m_inUse.load(std::memory_order_relaxed);
+    stats.highWatermark = m_highWatermark.load(std::memory_order_relaxed);
+    stats.failed = m_failed.load(std::memory_order_relaxed);
+    return stats;
+}
+
+PayloadPool* IRAM_ATTR PayloadPool::poolOf(uint32_t handle) {
+    uint32_t id = handlePool(handle);
+    if (id == 0 || id > MAX_POOLS) {
+        return nullptr;
+    }
+    return s_pools[id - 1].load(std::memory_order_acquire);
+}
+
+PayloadPool::Block* PayloadPool::blockOf(uint32_t handle) const {
+    uint32_t index = handleIndex(handle);
+    if (index >= m_blockCount) {
+        return nullptr;
+    }
+    Block& block = m_blocks[index];
+    if ((block.generation.load(std::memory_order_acquire) & 0xFF) != handleGeneration(handle)) {
+        return nullptr; // Block was freed and reused since the handle was made
+    }
+    return &block;
+}
+
+const uint8_t* PayloadPool::blockData(uint32_t index) const {
+    return reinterpret_cast<const uint8_t*>(&m_storage[index * m_stride]);
+}
+
+bool IRAM_ATTR PayloadPool::popFree(uint32_t& index) {
+    // Tag in the upper half changes on every update, so a head popped and pushed
+    // back between our load and CAS (ABA) fails the exchange
+    uint32_t head = m_freeHead.load(std::memory_order_acquire);
+    while (true) {
+        index = head & 0xFFFF;
+        if (index == EMPTY_INDEX) {
+            return false;
+        }
+        uint32_t next = m_blocks[index].next.load(std::memory_order_relaxed);
+        uint32_t updated = ((head + 0x10000) & 0xFFFF0000) | next;
+        if (m_freeHead.compare_exchange_weak(head, updated, std::memory_order_acq_rel, std::memory_order_acquire)) {
+            return true;
+        }
+    }
+}
+
+void IRAM_ATTR PayloadPool::pushFree(uint32_t index) {
+    uint32_t head = m_freeHead.load(std::memory_order_relaxed);
+    while (true) {
+        m_blocks[index].next.store(head & 0xFFFF, std::memory_order_relaxed);
+        uint32_t updated = ((head + 0x10000) & 0xFFFF0000) | index;
+        if (m_freeHead.compare_exchange_weak(head, updated, std::memory_order_release, std::memory_order_relaxed)) {
+            return;
+        }
+    }
+}
+
+void IRAM_ATTR PayloadPool::retainBlock(uint32_t handle) {
+    m_blocks[handleIndex(handle)].refs.fetch_add(1, std::memory_order_relaxed);
+}
+
+void IRAM_ATTR PayloadPool::releaseBlock(uint32_t handle) {
+    uint32_t index = handleIndex(handle);
+    Block& block = m_blocks[index];
+    if (block.refs.fetch_sub(1, std::memory_order_acq_rel) != 1) {
+        return;
+    }
+
+    // Last reference: invalidate outstanding handles, then hand the block back
+    block.generation.fetch_add(1, std::memory_order_release);
+    m_inUse.fetch_sub(1, std::memory_order_relaxed);
+    pushFree(index);
+}
+
+const void* PayloadRef::data() const {
+    PayloadPool* pool = PayloadPool::poolOf(m_handle);
+    if (!pool || !pool->blockOf(m_handle)) {
+        return nullptr;
+    }
+    return pool->blockData(m_handle & 0xFFFF);
+}
+
+size_t PayloadRef::size() const {
+    PayloadPool* pool = PayloadPool::poolOf(m_handle);
+    const PayloadPool::Block* block = pool ? pool->blockOf(m_handle) : nullptr;
+    return block ? block->size : 0;
+}
+
+void IRAM_ATTR PayloadRef::retain(uint32_t handle) {
+    if (PayloadPool* pool = PayloadPool::poolOf(handle)) {
+        pool->retainBlock(handle);
+    }
+}
+
+void IRAM_ATTR PayloadRef::release(uint32_t handle) {
+    if (PayloadPool* pool = PayloadPool::poolOf(handle)) {
+        pool->releaseBlock(handle);
+    }
+}
@@ -2,6 +2,9 @@
 #include "esp_log.h"
 
 static const char* TAG = "EntryGateController";
+
+// Handlers drive the barrier and the ticket service; anything slower delays the sensor lane
+static constexpr uint32_t HANDLER_BUDGET_US = 5000;
 static const char* entryGateStateToString(EntryGateState state);
 
 EntryGateController::EntryGateController(
@@ -9,7 +12,9 @@ EntryGateController::EntryGateController(
     IGpioInput& button,
     IGate& gate,
     ITicketService& ticketService,
-    uint32_t barrierTimeoutMs)
+    uint32_t barrierTimeoutMs,
+    uint8_t laneId,
+    SubscriptionMode mode)
     : m_eventBus(eventBus)
     , m_button(&button)
     , m_gate(&gate)
@@ -17,14 +22,26 @@ EntryGateController::EntryGateController(
     , m_state(EntryGateState::Idle)
     , m_barrierTimeoutMs(barrierTimeoutMs)
     , m_currentTicketId(0)
+    , m_laneId(laneId)
     , m_barrierTimer(nullptr) {
-    // Subscribe to events
-    m_eventBus.subscribe(EventType::EntryButtonPressed,
-                         [this](const Event& e) { onButtonPressed(e); });
-    m_eventBus.subscribe(EventType::EntryLightBarrierBlocked,
-                         [this](const Event& e) { onLightBarrierBlocked(e); });
-    m_eventBus.subscribe(EventType::EntryLightBarrierCleared,
-                         [this](const Event& e) { onLightBarrierCleared(e); });
+    // Subscribe to events (a StaticEventBus calls handle() instead)
+    if (mode == SubscriptionMode::Runtime) {
+        m_eventBus.subscribe(EventType::EntryButtonPressed,
+                             [this](const Event& e) { onButtonPressed(e); },
+                             SubscribeOptions{.name = "EntryGate.buttonPressed",
+                                              .budgetUs = HANDLER_BUDGET_US,
+                                              .source = m_laneId});
+        m_eventBus.subscribe(EventType::EntryLightBarrierBlocked,
+                             [this](const Event& e) { onLightBarrierBlocked(e); },
+                             SubscribeOptions{.name = "EntryGate.barrierBlocked",
+                                              .budgetUs = HANDLER_BUDGET_US,
+                                              .source = m_laneId});
+        m_eventBus.subscribe(EventType::EntryLightBarrierCleared,
+                             [this](const Event& e) { onLightBarrierCleared(e); },
+                             SubscribeOptions{.name = "EntryGate.barrierCleared",
+                                              .budgetUs = HANDLER_BUDGET_US,
+                                              .source = m_laneId});
+    }
 
     // Create barrier timer
     m_barrierTimer = xTimerCreate(
@@ -48,7 +65,7 @@ void EntryGateController::setupGpioInterrupts() {
     m_button->setInterruptHandler([this](bool level) {
         // Button pressed when level goes LOW (pull-up resistor)
         EventType eventType = level ? EventType::EntryButtonReleased : EventType::EntryButtonPressed;
-        Event event(eventType);
+        Event event = makeEvent(eventType);
         m_eventBus.publish(event);
     });
     m_button->enableInterrupt();
@@ -56,6 +73,10 @@ void EntryGateController::setupGpioInterrupts() {
     ESP_LOGI(TAG, "Entry gate GPIO interrupts configured");
 }
 
+Event EntryGateController::makeEvent(EventType type, EventPayload payload) const {
+    return Event(type, 0, payload, m_laneId);
+}
+
 const char* EntryGateController::getStateString() const {
     switch (m_state) {
         case EntryGateState::Idle:
@@ -118,7 +139,7 @@ void EntryGateController::onButtonPressed(const Event& event) {
 
     if (activeCount >= capacity) {
         ESP_LOGW(TAG, "Parking full! (%lu/%lu)", (unsigned long) activeCount, (unsigned long) capacity);
-        m_eventBus.publish(Event(EventType::CapacityFull));
+        m_eventBus.publish(makeEvent(EventType::CapacityFull));
         setState(EntryGateState::Idle);
         return;
     }
@@ -134,12 +155,16 @@ void EntryGateController::onButtonPressed(const Event& event) {
     }
 
     ESP_LOGI(TAG, "Ticket issued: ID=%lu", (unsigned long) m_currentTicketId);
-    m_eventBus.publish(Event(EventType::TicketIssued, 0, m_currentTicketId));
 
     // Open barrier
     setState(EntryGateState::OpeningBarrier);
     m_gate->open();
-    m_eventBus.publish(Event(EventType::EntryBarrierOpened));
+
+    // Ticket and barrier notifications are queued together
+    const Event events[] = {
+        makeEvent(EventType::TicketIssued, m_currentTicketId),
+        makeEvent(EventType::EntryBarrierOpened)};
+    m_eventBus.publishBatch(events);
     startBarrierTimer();
 }
 
@@ -155,7 +180,7 @@ void EntryGateController::onLightBarrierCleared(const Event& event) {
     (void) event;
     if (m_state == EntryGateState::CarPassing) {
         ESP_LOGI(TAG, "Car passed through, waiting %u ms before closing barrier", (unsigned) m_barrierTimeoutMs);
-        m_eventBus.publish(Event(EventType::CarEnteredParking, 0, m_currentTicketId));
+        m_eventBus.publish(makeEvent(EventType::CarEnteredParking, m_currentTicketId));
 
         // Wait before closing barrier (uses configured timeout)
         setState(EntryGateState::WaitingBeforeClose);
@@ -178,7 +203,7 @@ void EntryGateController::onBarrierTimeout() {
         ESP_LOGI(TAG, "Wait period finished, closing barrier");
         setState(EntryGateState::ClosingBarrier);
         m_gate->close();
-        m_eventBus.publish(Event(EventType::EntryBarrierClosed));
+        m_eventBus.publish(makeEvent(EventType::EntryBarrierClosed));
 
         // Start timer with normal barrier timeout
         if (m_barrierTimer) {
@@ -2,6 +2,9 @@
 #include "esp_log.h"
 
 static const char* TAG = "ExitGateController";
+
+// Handlers drive the barrier and the ticket service; anything slower delays the sensor lane
+static constexpr uint32_t HANDLER_BUDGET_US = 5000;
 static const char* exitGateStateToString(ExitGateState state);
 
 ExitGateController::ExitGateController(
@@ -9,7 +12,9 @@ ExitGateController::ExitGateController(
     IGate& gate,
     ITicketService& ticketService,
     uint32_t barrierTimeoutMs,
-    uint32_t validationTimeMs)
+    uint32_t validationTimeMs,
+    uint8_t laneId,
+    SubscriptionMode mode)
     : m_eventBus(eventBus)
     , m_gate(&gate)
     , m_ticketService(ticketService)
@@ -17,13 +22,22 @@ ExitGateController::ExitGateController(
     , m_barrierTimeoutMs(barrierTimeoutMs)
     , m_validationTimeMs(validationTimeMs)
     , m_currentTicketId(0)
+    , m_laneId(laneId)
     , m_barrierTimer(nullptr)
     , m_validationTimer(nullptr) {
-    // Subscribe to events
-    m_eventBus.subscribe(EventType::ExitLightBarrierBlocked,
-                         [this](const Event& e) { onLightBarrierBlocked(e); });
-    m_eventBus.subscribe(EventType::ExitLightBarrierCleared,
-                         [this](const Event& e) { onLightBarrierCleared(e); });
+    // Subscribe to events (a StaticEventBus calls handle() instead)
+    if (mode == SubscriptionMode::Runtime) {
+        m_eventBus.subscribe(EventType::ExitLightBarrierBlocked,
+                             [this](const Event& e) { onLightBarrierBlocked(e); },
+                             SubscribeOptions{.name = "ExitGate.barrierBlocked",
+                                              .budgetUs = HANDLER_BUDGET_US,
+                                              .source = m_laneId});
+        m_eventBus.subscribe(EventType::ExitLightBarrierCleared,
+                             [this](const Event& e) { onLightBarrierCleared(e); },
+                             SubscribeOptions{.name = "ExitGate.barrierCleared",
+                                              .budgetUs = HANDLER_BUDGET_US,
+                                              .source = m_laneId});
+    }
 
     // Create timers
     m_barrierTimer = xTimerCreate(
@@ -75,6 +89,10 @@ void ExitGateController::reset() {
     ESP_LOGI(TAG, "ExitGateController reset to Idle");
 }
 
+Event ExitGateController::makeEvent(EventType type, EventPayload payload) const {
+    return Event(type, 0, payload, m_laneId);
+}
+
 const char* ExitGateController::getStateString() const {
     switch (m_state) {
         case ExitGateState::Idle:
@@ -117,7 +135,7 @@ void ExitGateController::onLightBarrierCleared(const Event& event) {
     (void) event;
     if (m_state == ExitGateState::CarPassing) {
         ESP_LOGI(TAG, "Car exited parking, waiting %u ms before closing barrier", (unsigned) m_barrierTimeoutMs);
-        m_eventBus.publish(Event(EventType::CarExitedParking, 0, m_currentTicketId));
+        m_eventBus.publish(makeEvent(EventType::CarExitedParking, m_currentTicketId));
 
         // Wait before closing barrier (uses configured timeout)
         setState(ExitGateState::WaitingBeforeClose);
@@ -151,25 +169,29 @@ bool ExitGateController::validateTicketManually(uint32_t ticketId) {
         if (!ticket.isPaid) {
             ESP_LOGW(TAG, "Ticket not paid: ID=%lu - use 'ticket_pay %lu' command first!",
                      (unsigned long) ticketId, (unsigned long) ticketId);
-            m_eventBus.publish(Event(EventType::TicketRejected));
+            m_eventBus.publish(makeEvent(EventType::TicketRejected));
             setState(ExitGateState::Idle);
             return false;
         }
 
         if (m_ticketService.validateAndUseTicket(ticketId)) {
             ESP_LOGI(TAG, "Ticket validation successful: ID=%lu", (unsigned long) ticketId);
-            m_eventBus.publish(Event(EventType::TicketValidated, 0, ticketId));
 
             setState(ExitGateState::OpeningBarrier);
             m_gate->open();
-            m_eventBus.publish(Event(EventType::ExitBarrierOpened));
+
+            // Validation and barrier notifications are queued together
+            const Event events[] = {
+                makeEvent(EventType::TicketValidated, ticketId),
+                makeEvent(EventType::ExitBarrierOpened)};
+            m_eventBus.publishBatch(events);
             startBarrierTimer();
             return true;
         }
     }
 
     ESP_LOGW(TAG, "Ticket validation failed: ID=%lu", (unsigned long) ticketId);
-    m_eventBus.publish(Event(EventType::TicketRejected));
+    m_eventBus.publish(makeEvent(EventType::TicketRejected));
     setState(ExitGateState::Idle);
     return false;
 }
@@ -184,7 +206,7 @@ void ExitGateController::onBarrierTimeout() {
         ESP_LOGI(TAG, "Wait period finished, closing barrier");
         setState(ExitGateState::ClosingBarrier);
         m_gate->close();
-        m_eventBus.publish(Event(EventType::ExitBarrierClosed));
+        m_eventBus.publish(makeEvent(EventType::ExitBarrierClosed));
 
         // Start timer with normal barrier timeout
         if (m_barrierTimer) {
@@ -10,6 +10,7 @@ EspGpioInput::EspGpioInput(gpio_num_t pin, uint32_t debounceMs)
     : m_pin(pin)
     , m_debounceMs(debounceMs)
     , m_handler(nullptr)
+    , m_isrRing(nullptr)
     , m_lastInterruptTime(0) {
     // Configure GPIO: enable internal pull-up by default for stable input
     gpio_config_t io_conf = {};
@@ -41,8 +42,12 @@ void EspGpioInput::setInterruptHandler(std::function<void(bool level)> handler)
     m_handler = std::move(handler);
 }
 
+void EspGpioInput::setIsrEventRing(IsrEventRing* ring) {
+    m_isrRing = ring;
+}
+
 void EspGpioInput::enableInterrupt() {
-    if (!m_handler) {
+    if (!m_handler && !m_isrRing) {
         ESP_LOGW(TAG, "Cannot enable interrupt on GPIO %d: no handler set", m_pin);
         return;
     }
@@ -78,7 +83,9 @@ void EspGpioInput::disableInterrupt() {
 
 void EspGpioInput::simulateInterrupt(bool level) {
     ESP_LOGI(TAG, "Simulating interrupt on GPIO %d with level %d", m_pin, level);
-    if (m_handler) {
+    if (m_isrRing) {
+        m_isrRing->push(level, static_cast<uint32_t>(esp_timer_get_time()));
+    } else if (m_handler) {
         m_handler(level);
     }
 }
@@ -98,12 +105,12 @@ void IRAM_ATTR EspGpioInput::handleInterrupt() {
     static std::atomic<uint32_t> handle_count{0};
     handle_count.fetch_add(1, std::memory_order_relaxed);
 
-    // Read current level immediately
+    // Read current level and edge time immediately
     bool level = gpio_get_level(m_pin) != 0;
+    int64_t now = esp_timer_get_time();
 
     // Debouncing: check if enough time has passed since last interrupt
     if (m_debounceMs > 0) {
-        int64_t now = esp_timer_get_time();
         int64_t elapsed_ms = (now - m_lastInterruptTime) / 1000;
 
         if (elapsed_ms < m_debounceMs) {
@@ -116,6 +123,12 @@ void IRAM_ATTR EspGpioInput::handleInterrupt() {
         m_lastInterruptTime = now;
     }
 
+    // Preferred path: hand the edge to the event loop without leaving IRAM
+    if (m_isrRing) {
+        m_isrRing->pushFromISR(level, static_cast<uint32_t>(now));
+        return;
+    }
+
     // Call handler with current level
     if (m_handler) {
         m_handler(level);
@@ -4,6 +4,10 @@
 
 static const char* TAG = "ParkingGarageSystem";
 
+// Event source of the single entry/exit lane; another lane would get its own
+// controllers and ISR rings with the next source ID
+static constexpr uint8_t LANE_ID = 0;
+
 ParkingGarageSystem::ParkingGarageSystem(const ParkingGarageConfig& config)
     : m_config(config) {
     ESP_LOGI(TAG, "Creating ParkingGarageSystem (Dependency Injection)...");
@@ -15,7 +19,18 @@ ParkingGarageSystem::ParkingGarageSystem(const ParkingGarageConfig& config)
     ESP_LOGI(TAG, "  Exit Motor: GPIO %d", config.exitMotorPin);
 
     // 1. Create shared services
-    m_eventBus = std::make_unique<FreeRtosEventBus>(32);
+    // 64 packed events take the same RAM as 32 unpacked ones did; split evenly
+    // so sensor events keep 32 slots no matter how busy the low lane gets
+    m_eventBus = std::make_unique<FreeRtosEventBus>(32, 32);
+    // Capacity events report a level - when the lane is full only the latest one matters
+    m_eventBus->setOverflowPolicy(EventType::CapacityAvailable, OverflowPolicy::OverwriteLatest);
+    m_eventBus->setOverflowPolicy(EventType::CapacityFull, OverflowPolicy::OverwriteLatest);
+    // Light barriers are not debounced - merge sensor flicker while an edge is still queued
+    m_eventBus->setCoalescing(true);
+    // Gate handlers publish ticket and barrier events - dispatch those cascades without a queue round-trip
+    m_eventBus->setInlineDispatch(true);
+    // Console and other tasks can preempt the loop (priority 5) during a rush - raise it while the lanes back up
+    m_eventBus->setPriorityBoost(PriorityBoostConfig{.highWater = 16, .lowWater = 4, .priority = 10});
     m_ticketService = std::make_unique<TicketService>(config.capacity);
 
     // 2. Create hardware (owned by ParkingGarageSystem)
@@ -39,15 +54,16 @@ ParkingGarageSystem::ParkingGarageSystem(const ParkingGarageConfig& config)
         m_entryGateHw->getButton(), // Inject button
         *m_entryGateHw,             // Inject gate
         *m_ticketService,
-        config.barrierTimeoutMs);
+        config.barrierTimeoutMs,
+        LANE_ID);
 
     m_exitGate = std::make_unique<ExitGateController>(
         *m_eventBus,
         *m_exitGateHw, // Inject gate
         *m_ticketService,
         config.barrierTimeoutMs,
-        500 // validationTimeMs
-    );
+        500, // validationTimeMs
+        LANE_ID);
 
     ESP_LOGI(TAG, "ParkingGarageSystem created successfully");
 }
@@ -55,27 +71,32 @@ ParkingGarageSystem::ParkingGarageSystem(const ParkingGarageConfig& config)
 void ParkingGarageSystem::initialize() {
     ESP_LOGI(TAG, "Initializing ParkingGarageSystem...");
 
+    // Light barriers and entry button feed the event loop through ISR rings:
+    // the interrupt only stores level + timestamp (LOW = blocked/pressed)
+    if (m_entryGateHw->hasButton()) {
+        // Takes precedence over the handler installed by setupGpioInterrupts()
+        m_entryGateHw->getButton().setIsrEventRing(
+            m_eventBus->createIsrEventRing(EventType::EntryButtonPressed, EventType::EntryButtonReleased, LANE_ID));
+    }
+
     // Setup GPIO interrupts for entry gate (button + light barrier)
     m_entryGate->setupGpioInterrupts();
 
-    // Setup light barrier interrupt for exit gate
-    m_exitGateHw->getLightBarrier().setInterruptHandler([this](bool level) {
-        EventType eventType = level ? EventType::ExitLightBarrierCleared : EventType::ExitLightBarrierBlocked;
-        Event event(eventType);
-        m_eventBus->publish(event);
-    });
+    IsrEventRing* exitBarrierRing =
+        m_eventBus->createIsrEventRing(EventType::ExitLightBarrierBlocked, EventType::ExitLightBarrierCleared, LANE_ID);
+    m_exitGateHw->getLightBarrier().setIsrEventRing(exitBarrierRing);
     m_exitGateHw->getLightBarrier().enableInterrupt();
 
-    // Setup light barrier interrupt for entry gate
-    m_entryGateHw->getLightBarrier().setInterruptHandler([this](bool level) {
-        EventType eventType = level ? EventType::EntryLightBarrierCleared : EventType::EntryLightBarrierBlocked;
-        Event event(eventType);
-        m_eventBus->publish(event);
-    });
+    IsrEventRing* entryBarrierRing =
+        m_eventBus->createIsrEventRing(EventType::EntryLightBarrierBlocked, EventType::EntryLightBarrierCleared, LANE_ID);
+    m_entryGateHw->getLightBarrier().setIsrEventRing(entryBarrierRing);
     m_entryGateHw->getLightBarrier().enableInterrupt();
 
     m_exitGate->setupGpioInterrupts();
 
+    // All startup subscriptions are registered - switch to lock-free dispatch
+    m_eventBus->seal();
+
     ESP_LOGI(TAG, "ParkingGarageSystem initialized and ready");
 }
 
@@ -6,7 +6,8 @@ static const char* TAG = "TicketService";
 
 TicketService::TicketService(uint32_t capacity)
     : m_capacity(capacity)
-    , m_nextTicketId(1) {
+    , m_nextTicketId(1)
+    , m_activeCount(0) {
     m_mutex = xSemaphoreCreateMutex();
     if (!m_mutex) {
         ESP_LOGE(TAG, "Failed to create mutex");
@@ -24,13 +25,7 @@ TicketService::~TicketService() {
 uint32_t TicketService::getNewTicket() {
     if (xSemaphoreTake(m_mutex, portMAX_DELAY) == pdTRUE) {
         // Check capacity
-        uint32_t activeCount = 0;
-        for (const auto& [id, ticket] : m_tickets) {
-            if (!ticket.isUsed) {
-                activeCount++;
-            }
-        }
-
+        uint32_t activeCount = m_activeCount;
         if (activeCount >= m_capacity) {
             ESP_LOGW(TAG, "Parking full! Cannot issue new ticket (capacity: %lu)", m_capacity);
             xSemaphoreGive(m_mutex);
@@ -41,6 +36,8 @@ uint32_t TicketService::getNewTicket() {
         uint32_t ticketId = m_nextTicketId++;
         Ticket ticket(ticketId, esp_timer_get_time());
         m_tickets[ticketId] = ticket;
+        m_activeCount++;
+        checkActiveCountLocked();
 
         ESP_LOGI(TAG, "New ticket issued: ID=%lu (active: %lu/%lu)", ticketId, activeCount + 1, m_capacity);
 
@@ -101,6 +98,8 @@ bool TicketService::validateAndUseTicket(uint32_t ticketId) {
 
         // Mark as used
         it->second.isUsed = true;
+        m_activeCount--;
+        checkActiveCountLocked();
 
         ESP_LOGI(TAG, "Ticket validated and used: ID=%lu", ticketId);
 
@@ -129,17 +128,48 @@ uint32_t TicketService::getActiveTicketCount() const {
     uint32_t count = 0;
 
     if (xSemaphoreTake(m_mutex, portMAX_DELAY) == pdTRUE) {
-        for (const auto& [id, ticket] : m_tickets) {
-            if (!ticket.isUsed) {
-                count++;
-            }
-        }
+        count = m_activeCount;
         xSemaphoreGive(m_mutex);
     }
 
     return count;
 }
 
+bool TicketService::reconcileActiveTicketCount() {
+    bool consistent = false;
+
+    if (xSemaphoreTake(m_mutex, portMAX_DELAY) == pdTRUE) {
+        consistent = reconcileLocked();
+        xSemaphoreGive(m_mutex);
+    }
+
+    return consistent;
+}
+
+bool TicketService::reconcileLocked() {
+    uint32_t scanned = 0;
+    for (const auto& [id, ticket] : m_tickets) {
+        if (!ticket.isUsed) {
+            scanned++;
+        }
+    }
+
+    if (scanned != m_activeCount) {
+        ESP_LOGE(TAG, "Active ticket counter out of sync (counter: %lu, tickets: %lu), corrected",
+                 (unsigned long) m_activeCount, (unsigned long) scanned);
+        m_activeCount = scanned;
+        return false;
+    }
+    return true;
+}
+
+void TicketService::checkActiveCountLocked() {
+    // Debug builds only: a full scan per change is what the counter avoids
+#ifdef CONFIG_PARKING_TICKET_COUNT_CHECK
+    (void) reconcileLocked();
+#endif
+}
+
 uint32_t TicketService::getCapacity() const {
     return m_capacity;
 }
@@ -148,6 +178,7 @@ void TicketService::reset() {
     if (xSemaphoreTake(m_mutex, portMAX_DELAY) == pdTRUE) {
         m_tickets.clear();
         m_nextTicketId = 1;
+        m_activeCount = 0;
         ESP_LOGI(TAG, "TicketService reset: all tickets cleared");
         xSemaphoreGive(m_mutex);
     }
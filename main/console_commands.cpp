@@ -3,6 +3,7 @@
 #include "esp_log.h"
 #include "linenoise/linenoise.h"
 #include "argtable3/argtable3.h"
+#include "EventNameLookup.h"
 #include <cstring>
 
 static const char* TAG = "Console";
@@ -302,55 +303,324 @@ int cmd_publish(int argc, char** argv) {
     }
 
     if (argc < 2) {
-        printf("Usage: publish <event-name|list>\n");
+        printf("Usage: publish <event-name|list> [value]\n");
         printf("  publish list  - Show all available events\n");
-        printf("  publish <event-name>  - Publish an event\n");
+        printf("  publish <event-name> [value]  - Publish an event (value for events with payload)\n");
         return 1;
     }
 
     const char* eventName = argv[1];
 
-    // Show list of available events
+    // Show list of available events, grouped by category
     if (strcmp(eventName, "list") == 0) {
-        printf("\n=== Available Events ===\n\n");
-        printf("Entry Gate Events:\n");
-        printf("  EntryButtonPressed        - Simulate entry button press\n");
-        printf("  EntryLightBarrierBlocked  - Block entry light barrier\n");
-        printf("  EntryLightBarrierCleared  - Clear entry light barrier\n");
-        printf("\n");
-        printf("Exit Gate Events:\n");
-        printf("  ExitLightBarrierBlocked   - Block exit light barrier\n");
-        printf("  ExitLightBarrierCleared   - Clear exit light barrier\n");
+        printf("\n=== Available Events ===\n");
+        for (size_t bit = 0; bit < EVENT_CATEGORY_COUNT; bit++) {
+            EventCategoryMask category = static_cast<EventCategoryMask>(1u << bit);
+            printf("\n%s:\n", eventCategoryToString(category));
+            for (size_t i = 0; i < EVENT_TYPE_COUNT; i++) {
+                auto type = static_cast<EventType>(i);
+                if (eventCategory(type) == category) {
+                    printf("  %-26s%s\n", eventTypeToString(type), eventHasPayload(type) ? " <value>" : "");
+                }
+            }
+        }
         printf("\n");
         return 0;
     }
 
     // Publish the requested event
     EventType eventType;
-
-    if (strcmp(eventName, "EntryButtonPressed") == 0) {
-        eventType = EventType::EntryButtonPressed;
-    } else if (strcmp(eventName, "EntryLightBarrierBlocked") == 0) {
-        eventType = EventType::EntryLightBarrierBlocked;
-    } else if (strcmp(eventName, "EntryLightBarrierCleared") == 0) {
-        eventType = EventType::EntryLightBarrierCleared;
-    } else if (strcmp(eventName, "ExitLightBarrierBlocked") == 0) {
-        eventType = EventType::ExitLightBarrierBlocked;
-    } else if (strcmp(eventName, "ExitLightBarrierCleared") == 0) {
-        eventType = EventType::ExitLightBarrierCleared;
-    } else {
+    if (!eventTypeFromName(eventName, eventType)) {
         printf("Error: Unknown event '%s'\n", eventName);
         printf("Use 'publish list' to see available events\n");
         return 1;
     }
 
+    uint32_t value = argc >= 3 ? atoi(argv[2]) : 0;
     printf("Publishing event: %s\n", eventName);
-    Event event(eventType);
+    Event event(eventType, 0, makeEventPayload(eventType, value));
     g_system->getEventBus().publish(event);
 
     return 0;
 }
 
+// Command: queue (with subcommands: stats, reset, policy, boost)
+int cmd_queue(int argc, char** argv) {
+    if (!g_system) {
+        printf("Error: System not initialized\n");
+        return 1;
+    }
+
+    auto& eventBus = g_system->getEventBus();
+    const char* subcommand = argc >= 2 ? argv[1] : "stats";
+
+    // Subcommand: stats
+    if (strcmp(subcommand, "stats") == 0) {
+        EventBusStats stats = eventBus.getStats();
+        static const char* laneNames[EVENT_PRIORITY_COUNT] = {"high", "low"};
+
+        printf("=== Event Queue ===\n");
+        printf("Lane   Capacity  Queued  Peak\n");
+        for (size_t i = 0; i < EVENT_PRIORITY_COUNT; i++) {
+            printf("%-6s %8u  %6u  %4u\n", laneNames[i], (unsigned) stats.lanes[i].capacity,
+                   (unsigned) stats.lanes[i].queued, (unsigned) stats.lanes[i].highWatermark);
+        }
+
+        printf("\nEvent                      Published  Dropped  Merged  Inline  Queued  Peak  Policy\n");
+        for (size_t i = 0; i < EVENT_TYPE_COUNT; i++) {
+            auto type = static_cast<EventType>(i);
+            const EventTypeStats& typeStats = stats.types[i];
+            printf("%-26s %9lu  %7lu  %6lu  %6lu  %6lu  %4lu  %s\n", eventTypeToString(type),
+                   (unsigned long) typeStats.published, (unsigned long) typeStats.dropped,
+                   (unsigned long) typeStats.coalesced, (unsigned long) typeStats.inlined,
+                   (unsigned long) typeStats.queued, (unsigned long) typeStats.highWatermark,
+                   overflowPolicyToString(eventBus.getOverflowPolicy(type)));
+        }
+
+        PriorityBoostConfig boost = eventBus.getPriorityBoost();
+        if (boost.highWater > 0) {
+            printf("\nLoop priority boost: %u at %u queued, restored at %u (%s, %lu boosts, %llu ms boosted)\n",
+                   (unsigned) boost.priority, (unsigned) boost.highWater, (unsigned) boost.lowWater,
+                   stats.boost.active ? "active" : "idle", (unsigned long) stats.boost.boosts,
+                   (unsigned long long) (stats.boost.boostedUs / 1000));
+        }
+
+        std::vector<AsyncWorkerStats> workers = eventBus.getAsyncWorkerStats();
+        if (!workers.empty()) {
+            printf("\nAsync worker        Capacity  Queued  Peak  Delivered  Dropped\n");
+            for (const AsyncWorkerStats& worker : workers) {
+                printf("%-18s %9u  %6lu  %4lu  %9lu  %7lu\n", worker.name, (unsigned) worker.capacity,
+                       (unsigned long) worker.queued, (unsigned long) worker.highWatermark,
+                       (unsigned long) worker.delivered, (unsigned long) worker.dropped);
+            }
+        }
+        return 0;
+    }
+
+    // Subcommand: reset
+    if (strcmp(subcommand, "reset") == 0) {
+        eventBus.resetStats();
+        printf("Event queue statistics reset\n");
+        return 0;
+    }
+
+    // Subcommand: policy
+    if (strcmp(subcommand, "policy") == 0) {
+        if (argc < 4) {
+            printf("Usage: queue policy <event-name> <drop-newest|drop-oldest|block|overwrite>\n");
+            return 1;
+        }
+
+        const char* eventName = argv[2];
+        const char* policyName = argv[3];
+
+        EventType eventType;
+        if (!eventTypeFromName(eventName, eventType)) {
+            printf("Error: Unknown event '%s'\n", eventName);
+            return 1;
+        }
+
+        const OverflowPolicy policies[] = {OverflowPolicy::DropNewest, OverflowPolicy::DropOldest,
+                                           OverflowPolicy::BlockWithTimeout, OverflowPolicy::OverwriteLatest};
+        for (OverflowPolicy policy : policies) {
+            if (strcmp(policyName, overflowPolicyToString(policy)) == 0) {
+                eventBus.setOverflowPolicy(eventType, policy);
+                printf("Overflow policy of %s set to %s\n", eventName, policyName);
+                return 0;
+            }
+        }
+
+        printf("Error: Unknown policy '%s' (use: drop-newest, drop-oldest, block, overwrite)\n", policyName);
+        return 1;
+    }
+
+    // Subcommand: boost
+    if (strcmp(subcommand, "boost") == 0) {
+        if (argc == 3 && strcmp(argv[2], "off") == 0) {
+            eventBus.setPriorityBoost(PriorityBoostConfig{});
+            printf("Loop priority boost disabled\n");
+            return 0;
+        }
+        if (argc < 5) {
+            printf("Usage: queue boost <high-water> <low-water> <priority> | queue boost off\n");
+            return 1;
+        }
+
+        int highWater = atoi(argv[2]);
+        int lowWater = atoi(argv[3]);
+        int priority = atoi(argv[4]);
+        if (highWater <= 0 || lowWater < 0 || lowWater >= highWater || priority <= 0 ||
+            priority >= configMAX_PRIORITIES) {
+            printf("Error: Need 0 <= low-water < high-water and 0 < priority < %d\n", configMAX_PRIORITIES);
+            return 1;
+        }
+
+        eventBus.setPriorityBoost(PriorityBoostConfig{.highWater = static_cast<size_t>(highWater),
+                                                      .lowWater = static_cast<size_t>(lowWater),
+                                                      .priority = static_cast<UBaseType_t>(priority)});
+        printf("Loop priority boost: %d at %d queued, restored at %d\n", priority, highWater, lowWater);
+        return 0;
+    }
+
+    printf("Error: Unknown subcommand '%s'\n", subcommand);
+    printf("Usage: queue [stats|reset|policy <event-name> <policy>|boost <high> <low> <priority>|boost off]\n");
+    return 1;
+}
+
+// Command: trace (event flight recorder)
+int cmd_trace(int argc, char** argv) {
+    if (!g_system) {
+        printf("Error: System not initialized\n");
+        return 1;
+    }
+
+    EventTraceRecorder& recorder = g_system->getEventBus().getTraceRecorder();
+    const char* filter = argc >= 2 ? argv[1] : nullptr;
+
+    // Subcommand: clear
+    if (filter && strcmp(filter, "clear") == 0) {
+        recorder.clear();
+        printf("Event trace cleared\n");
+        return 0;
+    }
+
+    size_t maxCount = 20;
+    if (filter && filter[0] >= '0' && filter[0] <= '9') {
+        maxCount = static_cast<size_t>(atoi(filter));
+        filter = nullptr;
+    }
+
+    // Filter by event name or by kind (published, dropped, dispatched)
+    size_t typeFilter = EVENT_TYPE_COUNT;
+    int kindFilter = -1;
+    if (filter) {
+        EventType filterType;
+        if (eventTypeFromName(filter, filterType)) {
+            typeFilter = eventTypeIndex(filterType);
+        }
+        const TraceKind kinds[] = {TraceKind::Published, TraceKind::Dropped, TraceKind::Dispatched};
+        for (TraceKind kind : kinds) {
+            if (strcmp(filter, traceKindToString(kind)) == 0) {
+                kindFilter = static_cast<int>(kind);
+            }
+        }
+        if (typeFilter == EVENT_TYPE_COUNT && kindFilter < 0) {
+            printf("Error: Unknown filter '%s'\n", filter);
+            printf("Usage: trace [<n>|<event-name>|published|dropped|dispatched|clear]\n");
+            return 1;
+        }
+    }
+
+    // Static: 4 KB is too much for the console task stack
+    static TraceEntry entries[EventTraceRecorder::CAPACITY];
+    size_t count = recorder.snapshot(entries, EventTraceRecorder::CAPACITY);
+
+    // Select the newest matching entries, print them oldest first
+    size_t first = count;
+    size_t shown = 0;
+    while (first > 0 && shown < maxCount) {
+        const TraceEntry& entry = entries[first - 1];
+        if ((typeFilter == EVENT_TYPE_COUNT || entry.type == typeFilter) &&
+            (kindFilter < 0 || static_cast<int>(entry.kind) == kindFilter)) {
+            shown++;
+        }
+        first--;
+    }
+
+    printf("=== Event Trace (%lu recorded) ===\n", (unsigned long) recorder.recordedCount());
+    printf("Time (ms)   Kind        Event                       Src  Payload  Latency (us)\n");
+    for (size_t i = first; i < count; i++) {
+        const TraceEntry& entry = entries[i];
+        if ((typeFilter != EVENT_TYPE_COUNT && entry.type != typeFilter) ||
+            (kindFilter >= 0 && static_cast<int>(entry.kind) != kindFilter)) {
+            continue;
+        }
+
+        printf("%10lu  %-10s  %-26s  %3u  ", (unsigned long) (entry.publishTime / 1000), traceKindToString(entry.kind),
+               eventTypeToString(static_cast<EventType>(entry.type)), (unsigned) entry.source);
+        if (entry.payloadTag == static_cast<uint8_t>(PayloadTag::None)) {
+            printf("%7s", "-");
+        } else if (entry.payloadTag == static_cast<uint8_t>(PayloadTag::Pooled)) {
+            printf(" @%05lx", (unsigned long) (entry.payload & 0xFFFFF)); // Block generation and index
+        } else {
+            printf("%7lu", (unsigned long) entry.payload);
+        }
+        if (entry.kind == TraceKind::Dispatched) {
+            printf("  %lu", (unsigned long) (entry.dispatchTime - entry.publishTime));
+        }
+        printf("\n");
+    }
+    return 0;
+}
+
+// Command: stats (publish-to-dispatch latency, handler run times)
+int cmd_stats(int argc, char** argv) {
+    if (!g_system) {
+        printf("Error: System not initialized\n");
+        return 1;
+    }
+
+    auto& eventBus = g_system->getEventBus();
+    const char* subcommand = argc >= 2 ? argv[1] : "latency";
+
+    // Subcommand: reset
+    if (strcmp(subcommand, "reset") == 0) {
+        eventBus.resetStats();
+        printf("Event statistics reset\n");
+        return 0;
+    }
+
+    // Subcommand: handlers
+    if (strcmp(subcommand, "handlers") == 0) {
+        printf("=== Event Handlers (us) ===\n");
+        printf("Handler                    Event                        Calls     Avg     Max  Budget  Overruns\n");
+        for (const HandlerStats& handler : eventBus.getHandlerStats()) {
+            // Category handlers show their categories instead of a single event
+            char subscribed[32] = "";
+            if (handler.categories == 0) {
+                snprintf(subscribed, sizeof(subscribed), "%s", eventTypeToString(handler.type));
+            } else {
+                for (EventCategoryMask bit = 1; bit & EVENT_CATEGORY_ALL; bit <<= 1) {
+                    if (handler.categories & bit) {
+                        size_t used = strlen(subscribed);
+                        snprintf(subscribed + used, sizeof(subscribed) - used, "%s%s", used ? "|" : "*",
+                                 eventCategoryToString(bit));
+                    }
+                }
+            }
+            printf("%-26s %-26s %7lu %7lu %7lu %7lu  %8lu\n", handler.name ? handler.name : "unnamed", subscribed, (unsigned long) handler.calls, (unsigned long) handler.avgUs,
+                   (unsigned long) handler.maxUs, (unsigned long) handler.budgetUs, (unsigned long) handler.overruns);
+        }
+        printf("Total budget overruns: %lu\n", (unsigned long) eventBus.getBudgetOverruns());
+        return 0;
+    }
+
+    if (strcmp(subcommand, "latency") != 0) {
+        printf("Error: Unknown subcommand '%s'\n", subcommand);
+        printf("Usage: stats [latency|handlers|reset]\n");
+        return 1;
+    }
+
+    printf("=== Publish-to-Dispatch Latency (us) ===\n");
+    printf("Event                        Count     p50     p95     p99      Max\n");
+    bool any = false;
+    for (size_t i = 0; i < EVENT_TYPE_COUNT; i++) {
+        auto type = static_cast<EventType>(i);
+        LatencyStats latency = eventBus.getLatencyStats(type);
+        if (latency.count == 0) {
+            continue;
+        }
+        any = true;
+        printf("%-26s %7lu %7lu %7lu %7lu %8lu\n", eventTypeToString(type), (unsigned long) latency.count,
+               (unsigned long) latency.p50, (unsigned long) latency.p95, (unsigned long) latency.p99,
+               (unsigned long) latency.max);
+    }
+    if (!any) {
+        printf("(no events dispatched yet)\n");
+    }
+    return 0;
+}
+
 // Command: test (hardware test workflows)
 int cmd_test(int argc, char** argv) {
     if (!g_system) {
@@ -532,6 +802,12 @@ int cmd_help(int argc, char** argv) {
     printf("  parkgarage reset          - Reset entire system\n");
     printf("  publish <event>           - Publish event (use 'list')\n");
     printf("  gpio                      - GPIO read/write (use for usage)\n");
+    printf("  queue [stats|reset]       - Event queue counters and drops\n");
+    printf("  queue policy <event> <p>  - Set overflow policy of an event\n");
+    printf("  queue boost <h> <l> <p>   - Boost loop priority to p at h queued until l (or 'off')\n");
+    printf("  trace [n|event|kind|clear] - Dump recent event history\n");
+    printf("  stats [reset]             - Event latency p50/p95/p99 per type\n");
+    printf("  stats handlers            - Handler run times and budget overruns\n");
     printf("  test <entry|exit|full|info>  - Hardware test guides\n");
     printf("  ?                         - Show this help\n");
     printf("  help                      - Show ESP-IDF help\n");
@@ -572,7 +848,7 @@ void console_init(ParkingGarageSystem* system) {
 
     const esp_console_cmd_t publish_cmd = {
         .command = "publish",
-        .help = "Publish an event (use 'list' to see all)",
+        .help = "Publish an event with optional payload value (use 'list' to see all)",
         .hint = nullptr,
         .func = &cmd_publish,
         .argtable = nullptr,
@@ -592,6 +868,39 @@ void console_init(ParkingGarageSystem* system) {
     };
     esp_console_cmd_register(&gpio_cmd);
 
+    const esp_console_cmd_t queue_cmd = {
+        .command = "queue",
+        .help = "Event queue statistics (stats|reset|policy|boost)",
+        .hint = nullptr,
+        .func = &cmd_queue,
+        .argtable = nullptr,
+        .func_w_context = nullptr,
+        .context = nullptr,
+    };
+    esp_console_cmd_register(&queue_cmd);
+
+    const esp_console_cmd_t trace_cmd = {
+        .command = "trace",
+        .help = "Event flight recorder (n|event|published|dropped|dispatched|clear)",
+        .hint = nullptr,
+        .func = &cmd_trace,
+        .argtable = nullptr,
+        .func_w_context = nullptr,
+        .context = nullptr,
+    };
+    esp_console_cmd_register(&trace_cmd);
+
+    const esp_console_cmd_t stats_cmd = {
+        .command = "stats",
+        .help = "Event latency and handler run times (latency|handlers|reset)",
+        .hint = nullptr,
+        .func = &cmd_stats,
+        .argtable = nullptr,
+        .func_w_context = nullptr,
+        .context = nullptr,
+    };
+    esp_console_cmd_register(&stats_cmd);
+
     const esp_console_cmd_t help_cmd = {
         .command = "?",
         .help = "Show available commands",
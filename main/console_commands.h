@@ -18,5 +18,8 @@ int cmd_status(int argc, char** argv);
 int cmd_ticket(int argc, char** argv);
 int cmd_publish(int argc, char** argv);
 int cmd_gpio(int argc, char** argv);
+int cmd_queue(int argc, char** argv);
+int cmd_trace(int argc, char** argv);
+int cmd_stats(int argc, char** argv);
 int cmd_test(int argc, char** argv);
 int cmd_help(int argc, char** argv);
@@ -61,8 +61,7 @@ extern "C" void app_main(void) {
 
     // Start event loop (managed by EventBus)
     ESP_LOGI(TAG, "Starting event loop...");
-    auto& eventBus = static_cast<FreeRtosEventBus&>(g_parkingSystem->getEventBus());
-    eventBus.startEventLoop();
+    g_parkingSystem->getEventBus().startEventLoop();
 
 #ifdef CONFIG_PARKING_CONSOLE_ENABLED
     // Initialize console commands
@@ -0,0 +1,123 @@
+/**
+ * @file bench_event_dispatch.cpp
+ * @brief Host benchmark: EventHandler (InlineDelegate) vs std::function
+ *
+ * Measures construction (incl. heap allocations) and invocation cost of the
+ * handler types, using lambdas shaped like the gate controller subscriptions.
+ * Not part of CTest - run manually (make bench-host).
+ */
+
+#include "EventHandler.h"
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <functional>
+#include <new>
+#include <vector>
+
+static std::atomic<size_t> g_allocations{0};
+
+void* operator new(size_t size) {
+    g_allocations.fetch_add(1, std::memory_order_relaxed);
+    if (void* p = std::malloc(size)) {
+        return p;
+    }
+    throw std::bad_alloc();
+}
+
+void operator delete(void* p) noexcept {
+    std::free(p);
+}
+
+void operator delete(void* p, size_t) noexcept {
+    std::free(p);
+}
+
+namespace {
+
+constexpr size_t HANDLER_COUNT = 3;     // Handlers per event type (entry gate slot size)
+constexpr size_t EVENT_COUNT = 2000000; // Dispatched events per run
+
+/**
+ * @brief Stand-in for a gate controller receiving events
+ */
+struct Controller {
+    uint32_t received = 0;
+    uint32_t lastType = 0;
+
+    void onEvent(const Event& e) {
+        received++;
+        lastType = static_cast<uint32_t>(e.type);
+    }
+};
+
+template <typename Handler>
+struct Result {
+    double constructNs;
+    size_t allocations;
+    double dispatchNs;
+};
+
+template <typename Handler>
+Result<Handler> run(Controller& controller, uint32_t& extra1, uint32_t& extra2) {
+    using Clock = std::chrono::steady_clock;
+    Result<Handler> result{};
+
+    // Construction: `[this]` capture plus a larger three-reference capture
+    std::vector<Handler> handlers;
+    handlers.reserve(HANDLER_COUNT);
+    size_t allocBefore = g_allocations.load();
+    auto t0 = Clock::now();
+    handlers.emplace_back([&controller](const Event& e) { controller.onEvent(e); });
+    handlers.emplace_back([&controller, &extra1, &extra2](const Event& e) {
+        controller.onEvent(e);
+        extra1 += static_cast<uint32_t>(e.type);
+        extra2++;
+    });
+    handlers.emplace_back([&controller](const Event& e) { controller.onEvent(e); });
+    auto t1 = Clock::now();
+    result.allocations = g_allocations.load() - allocBefore;
+    result.constructNs = std::chrono::duration<double, std::nano>(t1 - t0).count() / HANDLER_COUNT;
+
+    // Dispatch: every event goes to all handlers of the slot
+    Event event(EventType::EntryLightBarrierBlocked);
+    t0 = Clock::now();
+    for (size_t i = 0; i < EVENT_COUNT; i++) {
+        for (const auto& handler : handlers) {
+            handler(event);
+        }
+    }
+    t1 = Clock::now();
+    result.dispatchNs = std::chrono::duration<double, std::nano>(t1 - t0).count() / (EVENT_COUNT * HANDLER_COUNT);
+
+    return result;
+}
+
+template <typename Handler>
+void print(const char* name, const Result<Handler>& r) {
+    printf("  %-22s sizeof=%3u  construct=%6.1f ns  allocs=%u  call=%5.2f ns\n",
+           name, (unsigned) sizeof(Handler), r.constructNs, (unsigned) r.allocations, r.dispatchNs);
+}
+
+} // namespace
+
+int main() {
+    printf("=================================\n");
+    printf("Event Handler Dispatch Benchmark\n");
+    printf("=================================\n\n");
+    printf("%u handlers, %u events\n\n", (unsigned) HANDLER_COUNT, (unsigned) EVENT_COUNT);
+
+    Controller controller;
+    uint32_t extra1 = 0;
+    uint32_t extra2 = 0;
+
+    auto function = run<std::function<void(const Event&)>>(controller, extra1, extra2);
+    auto delegate = run<EventHandler>(controller, extra1, extra2);
+
+    print("std::function", function);
+    print("EventHandler (inline)", delegate);
+
+    printf("\n(checksum %u/%u/%u)\n", controller.received, extra1, extra2);
+    return 0;
+}
@@ -0,0 +1,106 @@
+/**
+ * @file bench_event_throughput.cpp
+ * @brief Host benchmark: FreeRtosEventBus publish/dispatch throughput
+ *
+ * Runs the real bus on the host FreeRTOS stubs, so absolute numbers include
+ * the stub queue and are only comparable with each other. Modes:
+ * - single:  publish one event, receive and dispatch it (waitForEvent)
+ * - drain:   publish a burst, drain it in batches (processAllPending)
+ * - batch:   publish a burst as publishBatch pairs, drain in batches
+ * - static:  drain mode on StaticEventBus (compile-time dispatch, same queue)
+ * Not part of CTest - run manually (make bench-host).
+ */
+
+#include "FreeRtosEventBus.h"
+#include "StaticEventBus.h"
+#include <chrono>
+#include <cstdio>
+
+namespace {
+
+constexpr size_t EVENT_COUNT = 2000000;
+constexpr size_t BURST_SIZE = 32;
+
+using Clock = std::chrono::steady_clock;
+
+double eventsPerSecond(Clock::time_point start, Clock::time_point end) {
+    return EVENT_COUNT / std::chrono::duration<double>(end - start).count();
+}
+
+// Same two handlers as the runtime subscriptions below
+struct SinkSubscriber {
+    uint32_t sink = 0;
+
+    void handle(EventTag<EventType::EntryLightBarrierBlocked>, const Event& e) {
+        sink += static_cast<uint32_t>(e.type);
+        sink++;
+    }
+};
+
+} // namespace
+
+int main() {
+    printf("=================================\n");
+    printf("Event Bus Throughput Benchmark\n");
+    printf("=================================\n\n");
+
+    FreeRtosEventBus bus(64, 64);
+    uint32_t sink = 0;
+    bus.subscribe(EventType::EntryLightBarrierBlocked, [&sink](const Event& e) { sink += static_cast<uint32_t>(e.type); });
+    bus.subscribe(EventType::EntryLightBarrierBlocked, [&sink](const Event&) { sink++; });
+    bus.subscribe(EventType::TicketIssued, [&sink](const Event&) { sink++; });
+    bus.seal();
+
+    const Event event(EventType::EntryLightBarrierBlocked);
+    const Event chain[] = {Event(EventType::TicketIssued, 0, uint32_t{1}), event};
+
+    // single: one receive + one dispatch per event
+    Event out;
+    auto t0 = Clock::now();
+    for (size_t i = 0; i < EVENT_COUNT; i++) {
+        bus.publish(event);
+        (void) bus.waitForEvent(out, 0);
+    }
+    auto t1 = Clock::now();
+    printf("  single  %10.0f events/s\n", eventsPerSecond(t0, t1));
+
+    // drain: bursts drained up to EVENT_LOOP_BATCH_SIZE per table read
+    t0 = Clock::now();
+    for (size_t i = 0; i < EVENT_COUNT / BURST_SIZE; i++) {
+        for (size_t k = 0; k < BURST_SIZE; k++) {
+            bus.publish(event);
+        }
+        bus.processAllPending();
+    }
+    t1 = Clock::now();
+    printf("  drain   %10.0f events/s\n", eventsPerSecond(t0, t1));
+
+    // batch: two-event chains published with one slot reservation each
+    t0 = Clock::now();
+    for (size_t i = 0; i < EVENT_COUNT / BURST_SIZE; i++) {
+        for (size_t k = 0; k < BURST_SIZE / 2; k++) {
+            (void) bus.publishBatch(chain);
+        }
+        bus.processAllPending();
+    }
+    t1 = Clock::now();
+    printf("  batch   %10.0f events/s\n", eventsPerSecond(t0, t1));
+
+    // static: drain mode with handlers resolved at compile time
+    StaticEventBus<SinkSubscriber> staticBus(64, 64);
+    SinkSubscriber subscriber;
+    staticBus.bind(subscriber);
+    t0 = Clock::now();
+    for (size_t i = 0; i < EVENT_COUNT / BURST_SIZE; i++) {
+        for (size_t k = 0; k < BURST_SIZE; k++) {
+            staticBus.publish(event);
+        }
+        staticBus.processAllPending();
+    }
+    t1 = Clock::now();
+    printf("  static  %10.0f events/s\n", eventsPerSecond(t0, t1));
+    sink += subscriber.sink;
+
+    printf("\n(checksum %u)\n", sink);
+    return 0;
+}
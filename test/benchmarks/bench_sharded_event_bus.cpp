@@ -0,0 +1,114 @@
+/**
+ * @file bench_sharded_event_bus.cpp
+ * @brief Host benchmark: ShardedEventBus scaling with shard loop threads
+ *
+ * Runs ShardedEventBus<StdThreadEventBus> with 1, 2 and 4 shards, one pinned
+ * loop thread per shard, fed by one publisher thread per lane (BySource
+ * routing). Each handler does a fixed amount of work so the numbers show how
+ * dispatch scales with shards rather than queue overhead alone. Per-lane
+ * order is checked on every event.
+ * Not part of CTest - run manually (make bench-host).
+ */
+
+#include "ShardedEventBus.h"
+#include "StdThreadEventBus.h"
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <thread>
+#include <vector>
+
+namespace {
+
+constexpr uint8_t LANES = 4;
+constexpr uint32_t EVENTS_PER_LANE = 250000;
+constexpr uint32_t HANDLER_WORK = 200; // Loop iterations per handler call
+
+using Clock = std::chrono::steady_clock;
+
+// Stand-in for handler work (state machine, ticket lookup, logging)
+uint32_t busyWork(uint32_t seed) {
+    for (uint32_t i = 0; i < HANDLER_WORK; i++) {
+        seed = seed * 1664525u + 1013904223u;
+    }
+    return seed;
+}
+
+struct Result {
+    double eventsPerSecond;
+    bool ordered;
+};
+
+Result run(size_t shardCount) {
+    ShardedEventBus<StdThreadEventBus> bus(shardCount, ShardRouting::BySource, 1024, 1024);
+    for (size_t i = 0; i < shardCount; i++) {
+        bus.shard(i).setOverflowPolicy(OverflowPolicy::BlockWithTimeout);
+        bus.shard(i).setBlockTimeout(10000);
+    }
+
+    // One slot per lane; a lane is dispatched by exactly one shard thread
+    struct alignas(64) LaneState {
+        uint32_t next = 0;
+        uint32_t sink = 0;
+    };
+    std::array<LaneState, LANES> lanes{};
+    std::atomic<bool> ordered{true};
+    std::atomic<uint32_t> received{0};
+    bus.subscribe(EventType::EntryLightBarrierBlocked, [&](const Event& e) {
+        LaneState& lane = lanes[e.source];
+        uint32_t sequence = std::get<uint32_t>(e.payload);
+        if (sequence != lane.next) {
+            ordered.store(false, std::memory_order_relaxed);
+        }
+        lane.next = sequence + 1;
+        lane.sink += busyWork(sequence);
+        received.fetch_add(1, std::memory_order_relaxed);
+    });
+    bus.startEventLoops();
+
+    auto t0 = Clock::now();
+    std::vector<std::thread> publishers;
+    for (uint8_t lane = 0; lane < LANES; lane++) {
+        publishers.emplace_back([&bus, lane] {
+            for (uint32_t i = 0; i < EVENTS_PER_LANE; i++) {
+                bus.publish(Event(EventType::EntryLightBarrierBlocked, 0, i, lane));
+            }
+        });
+    }
+    for (auto& publisher : publishers) {
+        publisher.join();
+    }
+    while (received.load(std::memory_order_relaxed) < LANES * EVENTS_PER_LANE) {
+        std::this_thread::yield();
+    }
+    auto t1 = Clock::now();
+    bus.stopEventLoops();
+
+    double seconds = std::chrono::duration<double>(t1 - t0).count();
+    return Result{LANES * EVENTS_PER_LANE / seconds, ordered.load()};
+}
+
+} // namespace
+
+int main() {
+    printf("=================================\n");
+    printf("Sharded Event Bus Benchmark\n");
+    printf("=================================\n\n");
+    printf("%u lanes, %u events per lane, %u hardware threads\n\n", (unsigned) LANES, (unsigned) EVENTS_PER_LANE,
+           std::thread::hardware_concurrency());
+
+    double baseline = 0;
+    bool ordered = true;
+    for (size_t shards : {1, 2, 4}) {
+        Result result = run(shards);
+        if (baseline == 0) {
+            baseline = result.eventsPerSecond;
+        }
+        ordered = ordered && result.ordered;
+        printf("  %zu shard(s)  %10.0f events/s  (x%.2f)%s\n", shards, result.eventsPerSecond,
+               result.eventsPerSecond / baseline, result.ordered ? "" : "  ORDER VIOLATED");
+    }
+
+    return ordered ? 0 : 1;
+}
@@ -0,0 +1,155 @@
+/**
+ * @file bench_std_thread_event_bus.cpp
+ * @brief Host benchmark: full entry controller stack on StdThreadEventBus
+ *
+ * One EntryGateController per lane shares a TicketService and a single
+ * StdThreadEventBus loop thread. One sensor thread per lane publishes the
+ * complete car sequence (button, barrier timeouts, light barrier) while the
+ * loop thread runs the state machines, issues tickets and pays/validates
+ * them on CarEnteredParking. A lane's next car arrives once the previous one
+ * has entered (sensors flooding the high lane would starve the controllers'
+ * low-lane events, exactly as on the target). Shows publisher contention, car
+ * throughput and publish-to-dispatch latency as lanes are added.
+ * Not part of CTest - run manually (make bench-host).
+ */
+
+#include "EntryGateController.h"
+#include "MockGate.h"
+#include "MockGpioInput.h"
+#include "StdThreadEventBus.h"
+#include "TicketService.h"
+#include "esp_log.h"
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <memory>
+#include <thread>
+#include <vector>
+
+namespace {
+
+constexpr uint32_t CARS_PER_LANE = 2000;
+constexpr size_t QUEUE_SIZE = 256;
+
+// Sensor and timer events of one car, in the order the hardware produces them
+constexpr EventType CAR_SEQUENCE[] = {EventType::EntryButtonPressed, EventType::BarrierTimeout,
+                                      EventType::EntryLightBarrierBlocked, EventType::EntryLightBarrierCleared,
+                                      EventType::BarrierTimeout, EventType::BarrierTimeout};
+constexpr uint32_t EVENTS_PER_CAR = sizeof(CAR_SEQUENCE) / sizeof(CAR_SEQUENCE[0]);
+
+using Clock = std::chrono::steady_clock;
+
+struct Lane {
+    MockGpioInput button;
+    MockGate gate;
+    std::unique_ptr<EntryGateController> controller;
+    std::atomic<uint32_t> carsEntered{0};
+};
+
+struct Result {
+    double eventsPerSecond;
+    double carsPerSecond;
+    LatencyStats latency;
+    uint32_t dropped;
+    bool complete;
+};
+
+Result run(uint8_t laneCount) {
+    StdThreadEventBus bus(QUEUE_SIZE, QUEUE_SIZE);
+    bus.setOverflowPolicy(OverflowPolicy::BlockWithTimeout);
+    bus.setBlockTimeout(10000);
+    TicketService tickets(laneCount * CARS_PER_LANE);
+
+    std::vector<Lane> lanes(laneCount);
+    for (uint8_t id = 0; id < laneCount; id++) {
+        Lane& lane = lanes[id];
+        lane.controller = std::make_unique<EntryGateController>(bus, lane.button, lane.gate, tickets, 100, id);
+        // Host timers do not fire: deliver expiry as an event on the loop thread
+        bus.subscribe(EventType::BarrierTimeout,
+                      [&lane](const Event&) { lane.controller->TEST_forceBarrierTimeout(); },
+                      SubscribeOptions{.name = "Bench.barrierTimeout", .source = id});
+    }
+
+    std::atomic<uint32_t> cars{0};
+    bus.subscribe(EventType::CarEnteredParking, [&tickets, &cars, &lanes](const Event& e) {
+        uint32_t ticketId = eventPayload<EventType::CarEnteredParking>(e);
+        (void) tickets.payTicket(ticketId);
+        (void) tickets.validateAndUseTicket(ticketId);
+        lanes[e.source].carsEntered.fetch_add(1, std::memory_order_release);
+        cars.fetch_add(1, std::memory_order_relaxed);
+    });
+    bus.startEventLoop();
+
+    auto t0 = Clock::now();
+    std::vector<std::thread> sensors;
+    for (uint8_t id = 0; id < laneCount; id++) {
+        sensors.emplace_back([&bus, &lanes, id] {
+            for (uint32_t car = 0; car < CARS_PER_LANE; car++) {
+                for (EventType type : CAR_SEQUENCE) {
+                    bus.publish(Event(type, 0, std::monostate{}, id));
+                }
+                while (lanes[id].carsEntered.load(std::memory_order_acquire) <= car) {
+                    std::this_thread::yield();
+                }
+            }
+        });
+    }
+    for (auto& sensor : sensors) {
+        sensor.join();
+    }
+
+    // Each car's last timeout returns its lane to Idle; wait for the queues to drain
+    const uint64_t sensorEvents = uint64_t{laneCount} * CARS_PER_LANE * EVENTS_PER_CAR;
+    auto drained = [&bus] {
+        EventBusStats stats = bus.getStats();
+        return stats.lanes[0].queued == 0 && stats.lanes[1].queued == 0;
+    };
+    auto deadline = Clock::now() + std::chrono::seconds(30);
+    while ((cars.load(std::memory_order_relaxed) < laneCount * CARS_PER_LANE || !drained()) &&
+           Clock::now() < deadline) {
+        std::this_thread::yield();
+    }
+    auto t1 = Clock::now();
+    bus.stopEventLoop();
+
+    EventBusStats stats = bus.getStats();
+    uint32_t dropped = 0;
+    for (const EventTypeStats& type : stats.types) {
+        dropped += type.dropped;
+    }
+    bool complete = cars.load() == laneCount * CARS_PER_LANE;
+    for (const Lane& lane : lanes) {
+        complete = complete && lane.controller->getState() == EntryGateState::Idle;
+    }
+
+    double seconds = std::chrono::duration<double>(t1 - t0).count();
+    return Result{static_cast<double>(bus.dispatchedCount()) / seconds, cars.load() / seconds,
+                  bus.getLatencyStats(EventType::EntryButtonPressed), dropped,
+                  complete && bus.dispatchedCount() >= sensorEvents};
+}
+
+} // namespace
+
+int main() {
+    printf("=================================\n");
+    printf("StdThread Event Bus Benchmark\n");
+    printf("=================================\n\n");
+    printf("Entry controllers, %u cars per lane, %u hardware threads\n\n", (unsigned) CARS_PER_LANE,
+           std::thread::hardware_concurrency());
+
+    // Controller state logs would dominate the timings
+    esp_log_level_set("*", ESP_LOG_WARN);
+
+    bool complete = true;
+    for (uint8_t lanes : {1, 2, 4, 8}) {
+        Result result = run(lanes);
+        complete = complete && result.complete;
+        printf("  %u lane(s)  %9.0f events/s  %8.0f cars/s  button p50 %5lu us  p99 %6lu us  dropped %lu%s\n",
+               (unsigned) lanes, result.eventsPerSecond, result.carsPerSecond, (unsigned long) result.latency.p50,
+               (unsigned long) result.latency.p99, (unsigned long) result.dropped,
+               result.complete ? "" : "  INCOMPLETE");
+    }
+
+    esp_log_level_set("*", ESP_LOG_INFO);
+    return complete ? 0 : 1;
+}
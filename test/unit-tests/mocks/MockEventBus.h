@@ -1,21 +1,35 @@
 #pragma once
 
+#include "EventDispatchTable.h"
 #include "IEventBus.h"
 #include <queue>
-#include <map>
 #include <vector>
 
 /**
  * @brief Mock event bus for synchronous testing
  *
  * Provides deterministic event processing for unit tests.
+ * Uses the same EventDispatchTable as FreeRtosEventBus.
  */
 class MockEventBus : public IEventBus {
   public:
     MockEventBus() = default;
 
-    void subscribe(EventType type, std::function<void(const Event&)> handler) override {
-        m_subscribers[type].push_back(std::move(handler));
+    void subscribe(EventType type, EventHandler handler) override {
+        m_subscribers.add(type, std::move(handler));
+    }
+
+    void subscribe(EventType type, EventHandler handler, const SubscribeOptions& options) override {
+        m_subscribers.add(type, std::move(handler), nullptr, options.filter, options.source);
+    }
+
+    void subscribeCategory(EventCategoryMask categories, EventHandler handler) override {
+        m_subscribers.addCategory(categories, std::move(handler));
+    }
+
+    void subscribeCategory(EventCategoryMask categories, EventHandler handler,
+                           const SubscribeOptions& options) override {
+        m_subscribers.addCategory(categories, std::move(handler), nullptr, options.source);
     }
 
     void publish(const Event& event) override {
@@ -23,6 +37,13 @@ class MockEventBus : public IEventBus {
         m_history.push_back(event);
     }
 
+    bool publishBatch(std::span<const Event> events) override {
+        for (const auto& event : events) {
+            publish(event);
+        }
+        return true;
+    }
+
     void processAllPending() override {
         while (!m_queue.empty()) {
             Event event = m_queue.front();
@@ -61,17 +82,10 @@ class MockEventBus : public IEventBus {
 
   private:
     void dispatchEvent(const Event& event) {
-        auto it = m_subscribers.find(event.type);
-        if (it != m_subscribers.end()) {
-            for (const auto& handler : it->second) {
-                if (handler) {
-                    handler(event);
-                }
-            }
-        }
+        m_subscribers.dispatch(event);
     }
 
     std::queue<Event> m_queue;
-    std::map<EventType, std::vector<std::function<void(const Event&)>>> m_subscribers;
+    EventDispatchTable m_subscribers;
     std::vector<Event> m_history;
 };
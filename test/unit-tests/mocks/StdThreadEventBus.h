@@ -0,0 +1,498 @@
+#pragma once
+
+#include "EventBusStats.h"
+#include "EventDispatchTable.h"
+#include "IEventBus.h"
+#include "LatencyHistogram.h"
+#include "esp_timer.h"
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <span>
+#include <thread>
+#include <vector>
+
+#ifdef __linux__
+#include <pthread.h>
+#endif
+
+/**
+ * @brief Multithreaded IEventBus for Linux hosts (tests and benchmarks)
+ *
+ * The FreeRTOS host stubs never run tasks, so FreeRtosEventBus can only be
+ * driven synchronously off-target. This bus has the same queueing semantics
+ * on std::thread: a high and a low priority lane with their own bounded
+ * capacity (the high lane is always drained first), per-type overflow
+ * policies including parked OverwriteLatest events, all-or-nothing
+ * publishBatch(), latency histograms and per-type/per-lane statistics, and a
+ * real event loop thread (pinned to a CPU on Linux). Any number of threads
+ * may publish and consume.
+ *
+ * Not modelled: ISR rings, level coalescing, inline dispatch, handler
+ * profiling and async workers (async subscriptions run on the loop thread).
+ */
+class StdThreadEventBus : public IEventBus {
+  public:
+    /**
+     * @brief Maximum number of events the loop takes per lock
+     */
+    static constexpr size_t LOOP_BATCH_SIZE = 32;
+
+    explicit StdThreadEventBus(size_t highPriorityQueueSize = 32, size_t lowPriorityQueueSize = 32)
+        : m_table(std::make_shared<EventDispatchTable>()) {
+        m_lanes[static_cast<size_t>(EventPriority::High)].init(highPriorityQueueSize);
+        m_lanes[static_cast<size_t>(EventPriority::Low)].init(lowPriorityQueueSize);
+    }
+
+    ~StdThreadEventBus() override {
+        stopEventLoop();
+    }
+
+    // Prevent copying
+    StdThreadEventBus(const StdThreadEventBus&) = delete;
+    StdThreadEventBus& operator=(const StdThreadEventBus&) = delete;
+
+    void subscribe(EventType type, EventHandler handler) override {
+        subscribe(type, std::move(handler), SubscribeOptions{});
+    }
+
+    void subscribe(EventType type, EventHandler handler, const SubscribeOptions& options) override {
+        updateTable([&](EventDispatchTable& table) {
+            table.add(type, std::move(handler), nullptr, options.filter, options.source);
+        });
+    }
+
+    void subscribeCategory(EventCategoryMask categories, EventHandler handler) override {
+        subscribeCategory(categories, std::move(handler), SubscribeOptions{});
+    }
+
+    void subscribeCategory(EventCategoryMask categories, EventHandler handler,
+                           const SubscribeOptions& options) override {
+        updateTable([&](EventDispatchTable& table) {
+            (void) table.addCategory(categories, std::move(handler), nullptr, options.source);
+        });
+    }
+
+    void publish(const Event& event) override {
+        (void) enqueue(event, true);
+    }
+
+    /**
+     * @brief Publish without ever blocking (BlockWithTimeout drops), like from an ISR
+     */
+    bool publishFromISR(const Event& event) {
+        return enqueue(event, false);
+    }
+
+    bool publishBatch(std::span<const Event> events) override {
+        if (events.empty()) {
+            return true;
+        }
+
+        const uint64_t now = esp_timer_get_time();
+        std::array<size_t, EVENT_PRIORITY_COUNT> laneCounts{};
+        for (const Event& event : events) {
+            laneCounts[static_cast<size_t>(eventPriority(event.type))]++;
+        }
+
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            bool fits = true;
+            for (size_t i = 0; i < EVENT_PRIORITY_COUNT; i++) {
+                fits = fits && m_lanes[i].free() >= laneCounts[i];
+            }
+            for (const Event& event : events) {
+                m_typeStats[eventTypeIndex(event.type)].published++;
+                if (!fits) {
+                    m_typeStats[eventTypeIndex(event.type)].dropped++;
+                }
+            }
+            if (!fits) {
+                return false; // Queued completely or not at all
+            }
+            for (const Event& event : events) {
+                pushLocked(stamped(event, now));
+            }
+        }
+        m_notEmpty.notify_all();
+        return true;
+    }
+
+    void processAllPending() override {
+        std::vector<Event> batch;
+        batch.reserve(LOOP_BATCH_SIZE);
+        while (takeBatch(batch, std::chrono::milliseconds(0))) {
+            dispatchBatch(batch);
+        }
+    }
+
+    [[nodiscard]] bool waitForEvent(Event& outEvent, uint32_t timeoutMs) override {
+        std::vector<Event> batch;
+        auto timeout = timeoutMs == portMAX_DELAY ? std::chrono::milliseconds::max()
+                                                  : std::chrono::milliseconds(timeoutMs);
+        if (!takeBatch(batch, timeout, 1)) {
+            return false;
+        }
+        outEvent = batch.front();
+        dispatchBatch(batch);
+        return true;
+    }
+
+    /**
+     * @brief Start the loop thread (stack size and priority are ignored on the host)
+     * @param core CPU to pin the thread to, tskNO_AFFINITY for any
+     */
+    void startEventLoop(uint32_t stackSize = 4096, UBaseType_t priority = 5,
+                        const char* taskName = "event_loop", BaseType_t core = tskNO_AFFINITY) {
+        (void) stackSize;
+        (void) priority;
+        (void) taskName;
+        if (m_thread.joinable()) {
+            return;
+        }
+
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_stopRequested = false;
+        }
+        m_thread = std::thread([this] {
+            m_loopThreadId.store(std::this_thread::get_id(), std::memory_order_release);
+            loop();
+        });
+#ifdef __linux__
+        if (core != tskNO_AFFINITY) {
+            cpu_set_t cpus;
+            CPU_ZERO(&cpus);
+            CPU_SET(static_cast<unsigned>(core) % std::max(1u, std::thread::hardware_concurrency()), &cpus);
+            (void) pthread_setaffinity_np(m_thread.native_handle(), sizeof(cpus), &cpus);
+        }
+#else
+        (void) core;
+#endif
+    }
+
+    /**
+     * @brief Stop the loop thread after its current batch and join it
+     *
+     * Called from a handler on the loop thread, it only requests the stop
+     * (as FreeRtosEventBus does); the next call from another thread joins.
+     */
+    void stopEventLoop() {
+        if (!m_thread.joinable()) {
+            return;
+        }
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_stopRequested = true;
+        }
+        m_notEmpty.notify_all();
+        m_notFull.notify_all();
+        if (onLoopThread()) {
+            return; // Joining our own thread would throw
+        }
+        m_thread.join();
+        m_loopThreadId.store(std::thread::id(), std::memory_order_release);
+
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_stopRequested = false; // Events left queued stay available to processAllPending()
+    }
+
+    [[nodiscard]] bool isEventLoopRunning() const {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        return m_thread.joinable() && !m_stopRequested;
+    }
+
+    [[nodiscard]] size_t queueCapacity(EventPriority priority) const {
+        return m_lanes[static_cast<size_t>(priority)].capacity;
+    }
+
+    void setOverflowPolicy(OverflowPolicy policy) {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_overflowPolicies.fill(policy);
+    }
+
+    void setOverflowPolicy(EventType type, OverflowPolicy policy) {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_overflowPolicies[eventTypeIndex(type)] = policy;
+    }
+
+    [[nodiscard]] OverflowPolicy getOverflowPolicy(EventType type) const {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        return m_overflowPolicies[eventTypeIndex(type)];
+    }
+
+    /**
+     * @brief Set how long BlockWithTimeout waits for a free slot (the loop thread never blocks)
+     */
+    void setBlockTimeout(uint32_t timeoutMs) {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_blockTimeout = std::chrono::milliseconds(timeoutMs);
+    }
+
+    [[nodiscard]] EventBusStats getStats() const {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        EventBusStats stats;
+        stats.types = m_typeStats;
+        for (size_t i = 0; i < EVENT_PRIORITY_COUNT; i++) {
+            stats.lanes[i].capacity = m_lanes[i].capacity;
+            stats.lanes[i].queued = m_lanes[i].count;
+            stats.lanes[i].highWatermark = m_lanes[i].highWatermark;
+        }
+        return stats;
+    }
+
+    /**
+     * @brief Get publish-to-dispatch latency percentiles of an event type (us)
+     */
+    [[nodiscard]] LatencyStats getLatencyStats(EventType type) const {
+        return m_latency[eventTypeIndex(type)].getStats();
+    }
+
+    /**
+     * @brief Get number of events dispatched (loop thread and processAllPending/waitForEvent)
+     */
+    [[nodiscard]] uint64_t dispatchedCount() const {
+        return m_dispatched.load(std::memory_order_relaxed);
+    }
+
+    void resetStats() {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        for (size_t i = 0; i < EVENT_TYPE_COUNT; i++) {
+            uint32_t queued = m_typeStats[i].queued;
+            m_typeStats[i] = EventTypeStats{};
+            m_typeStats[i].queued = queued;
+            m_typeStats[i].highWatermark = queued;
+            m_latency[i].reset();
+        }
+        for (Lane& lane : m_lanes) {
+            lane.highWatermark = lane.count;
+        }
+    }
+
+  private:
+    /**
+     * @brief Bounded FIFO ring, preallocated (guarded by m_mutex)
+     */
+    struct Lane {
+        std::vector<Event> slots;
+        size_t capacity = 0;
+        size_t head = 0;
+        size_t count = 0;
+        size_t highWatermark = 0;
+        std::array<std::optional<Event>, EVENT_TYPE_COUNT> parked; // OverwriteLatest events waiting for room
+
+        void init(size_t size) {
+            capacity = size;
+            slots.resize(size);
+        }
+
+        [[nodiscard]] size_t free() const {
+            return capacity - count;
+        }
+
+        void push(const Event& event) {
+            slots[(head + count) % capacity] = event;
+            count++;
+            highWatermark = std::max(highWatermark, count);
+        }
+
+        Event pop() {
+            Event event = std::move(slots[head]);
+            head = (head + 1) % capacity;
+            count--;
+            return event;
+        }
+    };
+
+    static Event stamped(const Event& event, uint64_t now) {
+        Event copy = event;
+        if (copy.timestamp == 0) {
+            copy.timestamp = now;
+        }
+        return copy;
+    }
+
+    Lane& laneFor(EventType type) {
+        return m_lanes[static_cast<size_t>(eventPriority(type))];
+    }
+
+    [[nodiscard]] bool onLoopThread() const {
+        return std::this_thread::get_id() == m_loopThreadId.load(std::memory_order_acquire);
+    }
+
+    bool enqueue(const Event& event, bool mayBlock) {
+        const Event queued = stamped(event, esp_timer_get_time());
+        const size_t index = eventTypeIndex(event.type);
+        {
+            std::unique_lock<std::mutex> lock(m_mutex);
+            EventTypeStats& stats = m_typeStats[index];
+            Lane& lane = laneFor(event.type);
+            stats.published++;
+
+            const OverflowPolicy policy = m_overflowPolicies[index];
+            // While an event of this type is parked, newer ones replace it instead of overtaking it
+            if (policy == OverflowPolicy::OverwriteLatest && lane.parked[index]) {
+                parkLocked(queued);
+                return true;
+            }
+
+            if (lane.free() == 0) {
+                bool haveSlot = false;
+                switch (policy) {
+                    case OverflowPolicy::DropNewest:
+                        break;
+                    case OverflowPolicy::DropOldest:
+                        m_typeStats[eventTypeIndex(lane.slots[lane.head].type)].dropped++;
+                        m_typeStats[eventTypeIndex(lane.slots[lane.head].type)].queued--;
+                        (void) lane.pop();
+                        haveSlot = true;
+                        break;
+                    case OverflowPolicy::BlockWithTimeout:
+                        // Never block the only thread that can free a slot
+                        haveSlot = mayBlock && !onLoopThread() &&
+                                   m_notFull.wait_for(lock, m_blockTimeout,
+                                                      [&lane, this] { return lane.free() > 0 || m_stopRequested; }) &&
+                                   lane.free() > 0;
+                        break;
+                    case OverflowPolicy::OverwriteLatest:
+                        parkLocked(queued);
+                        return true;
+                }
+                if (!haveSlot) {
+                    stats.dropped++;
+                    return false;
+                }
+            }
+            pushLocked(queued);
+        }
+        m_notEmpty.notify_one();
+        return true;
+    }
+
+    void pushLocked(const Event& event) {
+        laneFor(event.type).push(event);
+        EventTypeStats& stats = m_typeStats[eventTypeIndex(event.type)];
+        stats.queued++;
+        stats.highWatermark = std::max(stats.highWatermark, stats.queued);
+    }
+
+    void parkLocked(const Event& event) {
+        const size_t index = eventTypeIndex(event.type);
+        std::optional<Event>& slot = laneFor(event.type).parked[index];
+        EventTypeStats& stats = m_typeStats[index];
+        if (slot) {
+            stats.dropped++; // Overwritten event is lost, the queued count stays the same
+        } else {
+            stats.queued++;
+            stats.highWatermark = std::max(stats.highWatermark, stats.queued);
+            m_parkedCount++;
+        }
+        slot = event;
+    }
+
+    [[nodiscard]] bool hasQueuedLocked() const {
+        return m_parkedCount > 0 || std::any_of(m_lanes.begin(), m_lanes.end(), [](const Lane& lane) {
+                   return lane.count > 0;
+               });
+    }
+
+    /**
+     * @brief Take up to maxCount events: high lane first, each lane's parked events after its queue
+     * @return false on timeout or stop request with nothing taken
+     */
+    template <typename Duration>
+    bool takeBatch(std::vector<Event>& batch, Duration timeout, size_t maxCount = LOOP_BATCH_SIZE) {
+        batch.clear();
+        {
+            std::unique_lock<std::mutex> lock(m_mutex);
+            auto ready = [this] { return hasQueuedLocked() || m_stopRequested; };
+            if (timeout == Duration::max()) {
+                m_notEmpty.wait(lock, ready);
+            } else if (!m_notEmpty.wait_for(lock, timeout, ready)) {
+                return false;
+            }
+
+            for (Lane& lane : m_lanes) {
+                while (lane.count > 0 && batch.size() < maxCount) {
+                    batch.push_back(lane.pop());
+                }
+                for (size_t i = 0; i < EVENT_TYPE_COUNT && batch.size() < maxCount && m_parkedCount > 0; i++) {
+                    if (lane.parked[i]) {
+                        batch.push_back(std::move(*lane.parked[i]));
+                        lane.parked[i].reset();
+                        m_parkedCount--;
+                    }
+                }
+            }
+            for (const Event& event : batch) {
+                m_typeStats[eventTypeIndex(event.type)].queued--;
+            }
+        }
+        if (!batch.empty()) {
+            m_notFull.notify_all();
+        }
+        return !batch.empty();
+    }
+
+    void dispatchBatch(const std::vector<Event>& batch) {
+        // One table snapshot per batch; subscribers added meanwhile see the next batch
+        std::shared_ptr<const EventDispatchTable> table;
+        {
+            std::lock_guard<std::mutex> lock(m_tableMutex);
+            table = m_table;
+        }
+        for (const Event& event : batch) {
+            auto now = static_cast<uint64_t>(esp_timer_get_time());
+            m_latency[eventTypeIndex(event.type)].record(
+                now > event.timestamp ? static_cast<uint32_t>(now - event.timestamp) : 0);
+            table->dispatch(event);
+            m_dispatched.fetch_add(1, std::memory_order_relaxed);
+        }
+    }
+
+    template <typename Update>
+    void updateTable(Update&& update) {
+        // Copy-on-write: batches being dispatched keep their snapshot
+        std::lock_guard<std::mutex> lock(m_tableMutex);
+        auto table = std::make_shared<EventDispatchTable>(*m_table);
+        update(*table);
+        m_table = std::move(table);
+    }
+
+    void loop() {
+        std::vector<Event> batch;
+        batch.reserve(LOOP_BATCH_SIZE);
+        while (takeBatch(batch, std::chrono::milliseconds::max())) {
+            dispatchBatch(batch);
+            std::lock_guard<std::mutex> lock(m_mutex);
+            if (m_stopRequested) {
+                break;
+            }
+        }
+    }
+
+    mutable std::mutex m_mutex; // Guards lanes, statistics, policies and m_stopRequested
+    std::condition_variable m_notEmpty;
+    std::condition_variable m_notFull;
+    std::array<Lane, EVENT_PRIORITY_COUNT> m_lanes;
+    size_t m_parkedCount = 0;
+    std::array<OverflowPolicy, EVENT_TYPE_COUNT> m_overflowPolicies{};
+    std::chrono::milliseconds m_blockTimeout{10};
+    std::array<EventTypeStats, EVENT_TYPE_COUNT> m_typeStats{};
+    bool m_stopRequested = false;
+
+    std::mutex m_tableMutex; // Guards m_table (the pointer, not the table)
+    std::shared_ptr<const EventDispatchTable> m_table;
+
+    std::array<LatencyHistogram, EVENT_TYPE_COUNT> m_latency{};
+    std::atomic<uint64_t> m_dispatched{0};
+    std::thread m_thread;
+    std::atomic<std::thread::id> m_loopThreadId{};
+};
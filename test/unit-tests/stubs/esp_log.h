@@ -2,7 +2,42 @@
 
 #include <cstdio>
 
-#define ESP_LOGI(TAG, FMT, ...) std::printf("I (%s) " FMT "\n", TAG, ##__VA_ARGS__)
-#define ESP_LOGD(TAG, FMT, ...) std::printf("D (%s) " FMT "\n", TAG, ##__VA_ARGS__)
-#define ESP_LOGW(TAG, FMT, ...) std::printf("W (%s) " FMT "\n", TAG, ##__VA_ARGS__)
-#define ESP_LOGE(TAG, FMT, ...) std::printf("E (%s) " FMT "\n", TAG, ##__VA_ARGS__)
+// Compile-time maximum, as CONFIG_LOG_MAXIMUM_LEVEL (INFO) does on target
+#ifndef LOG_LOCAL_LEVEL
+#define LOG_LOCAL_LEVEL ESP_LOG_INFO
+#endif
+
+typedef enum {
+    ESP_LOG_NONE,
+    ESP_LOG_ERROR,
+    ESP_LOG_WARN,
+    ESP_LOG_INFO,
+    ESP_LOG_DEBUG,
+    ESP_LOG_VERBOSE,
+} esp_log_level_t;
+
+inline esp_log_level_t g_esp_log_level = ESP_LOG_INFO;
+
+// Host stub keeps a single level for all tags (benchmarks silence controller logs with "*")
+inline void esp_log_level_set(const char* tag, esp_log_level_t level) {
+    (void) tag;
+    g_esp_log_level = level;
+}
+
+#define ESP_LOG_HOST(LEVEL, PREFIX, TAG, FMT, ...)                                    \
+    do {                                                                              \
+        if (g_esp_log_level >= (LEVEL)) {                                             \
+            std::printf(PREFIX " (%s) " FMT "\n", TAG, ##__VA_ARGS__);                \
+        }                                                                             \
+    } while (0)
+
+#define ESP_LOGI(TAG, FMT, ...) ESP_LOG_HOST(ESP_LOG_INFO, "I", TAG, FMT, ##__VA_ARGS__)
+// Debug logs compiled out below LOG_LOCAL_LEVEL, arguments still referenced and format-checked
+#define ESP_LOGD(TAG, FMT, ...)                                                       \
+    do {                                                                              \
+        if (LOG_LOCAL_LEVEL >= ESP_LOG_DEBUG) {                                       \
+            ESP_LOG_HOST(ESP_LOG_DEBUG, "D", TAG, FMT, ##__VA_ARGS__);                \
+        }                                                                             \
+    } while (0)
+#define ESP_LOGW(TAG, FMT, ...) ESP_LOG_HOST(ESP_LOG_WARN, "W", TAG, FMT, ##__VA_ARGS__)
+#define ESP_LOGE(TAG, FMT, ...) ESP_LOG_HOST(ESP_LOG_ERROR, "E", TAG, FMT, ##__VA_ARGS__)
@@ -35,3 +35,18 @@ typedef void* TaskHandle_t;
 #endif
 
 #define configMINIMAL_STACK_SIZE (1024)
+
+// ESP32 is dual-core
+#ifndef portNUM_PROCESSORS
+#define portNUM_PROCESSORS 2
+#endif
+
+// Spinlock for critical sections (no-op: host tests are single-threaded)
+typedef struct {
+    uint32_t owner;
+    uint32_t count;
+} portMUX_TYPE;
+
+#define portMUX_INITIALIZER_UNLOCKED {0, 0}
+#define portENTER_CRITICAL_SAFE(mux) (void) (mux)
+#define portEXIT_CRITICAL_SAFE(mux) (void) (mux)
@@ -2,32 +2,73 @@
 
 #include "freertos/FreeRTOS.h"
 
+// C++ headers must be outside extern "C" block
+#ifdef __cplusplus
+#include <cstring>
+#include <deque>
+#include <vector>
+#endif
+
 #ifdef __cplusplus
 extern "C" {
 #endif
 
+// Single-threaded FIFO stand-in for a FreeRTOS queue (copies items by value)
 typedef struct QueueStub {
-    int dummy;
+    UBaseType_t length;
+    UBaseType_t itemSize;
+    std::deque<std::vector<uint8_t>> items;
 }* QueueHandle_t;
 
-static inline QueueHandle_t xQueueCreate(UBaseType_t /*uxQueueLength*/, UBaseType_t /*uxItemSize*/) {
-    return new QueueStub{0};
+static inline QueueHandle_t xQueueCreate(UBaseType_t uxQueueLength, UBaseType_t uxItemSize) {
+    return new QueueStub{uxQueueLength, uxItemSize, {}};
 }
 
 static inline void vQueueDelete(QueueHandle_t xQueue) {
     delete xQueue;
 }
 
-static inline BaseType_t xQueueSend(QueueHandle_t /*xQueue*/, const void* /*pvItemToQueue*/, TickType_t /*xTicksToWait*/) {
+static inline BaseType_t xQueueSend(QueueHandle_t xQueue, const void* pvItemToQueue, TickType_t /*xTicksToWait*/) {
+    if (xQueue->items.size() >= xQueue->length) {
+        return pdFALSE; // errQUEUE_FULL - host stub never blocks
+    }
+    const auto* bytes = static_cast<const uint8_t*>(pvItemToQueue);
+    xQueue->items.emplace_back(bytes, bytes + xQueue->itemSize);
     return pdPASS;
 }
 
-static inline BaseType_t xQueueReceive(QueueHandle_t /*xQueue*/, void* /*pvBuffer*/, TickType_t /*xTicksToWait*/) {
-    return pdFALSE; // No items in stub queue
+static inline BaseType_t xQueueSendToFront(QueueHandle_t xQueue, const void* pvItemToQueue, TickType_t /*xTicksToWait*/) {
+    if (xQueue->items.size() >= xQueue->length) {
+        return pdFALSE; // errQUEUE_FULL - host stub never blocks
+    }
+    const auto* bytes = static_cast<const uint8_t*>(pvItemToQueue);
+    xQueue->items.emplace_front(bytes, bytes + xQueue->itemSize);
+    return pdPASS;
 }
 
-static inline BaseType_t xQueueSendFromISR(QueueHandle_t /*xQueue*/, const void* /*pvItemToQueue*/, BaseType_t* /*pxHigherPriorityTaskWoken*/) {
-    return pdPASS;
+static inline BaseType_t xQueueReceive(QueueHandle_t xQueue, void* pvBuffer, TickType_t /*xTicksToWait*/) {
+    if (xQueue->items.empty()) {
+        return pdFALSE; // Host stub never blocks
+    }
+    std::memcpy(pvBuffer, xQueue->items.front().data(), xQueue->itemSize);
+    xQueue->items.pop_front();
+    return pdTRUE;
+}
+
+static inline BaseType_t xQueueSendFromISR(QueueHandle_t xQueue, const void* pvItemToQueue, BaseType_t* /*pxHigherPriorityTaskWoken*/) {
+    return xQueueSend(xQueue, pvItemToQueue, 0);
+}
+
+static inline BaseType_t xQueueReceiveFromISR(QueueHandle_t xQueue, void* pvBuffer, BaseType_t* /*pxHigherPriorityTaskWoken*/) {
+    return xQueueReceive(xQueue, pvBuffer, 0);
+}
+
+static inline UBaseType_t uxQueueMessagesWaiting(QueueHandle_t xQueue) {
+    return static_cast<UBaseType_t>(xQueue->items.size());
+}
+
+static inline UBaseType_t uxQueueSpacesAvailable(QueueHandle_t xQueue) {
+    return xQueue->length - static_cast<UBaseType_t>(xQueue->items.size());
 }
 
 #ifdef __cplusplus
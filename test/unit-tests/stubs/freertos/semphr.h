@@ -6,26 +6,51 @@
 extern "C" {
 #endif
 
+// Mutexes always succeed (single-threaded tests). Binary semaphores keep their
+// state so signal/wait logic can be tested; a take on an empty one fails
+// immediately instead of blocking.
 typedef struct SemaphoreStub {
-    int dummy;
+    bool isMutex;
+    int count;
 }* SemaphoreHandle_t;
 
 static inline SemaphoreHandle_t xSemaphoreCreateMutex(void) {
-    return new SemaphoreStub{0};
+    return new SemaphoreStub{true, 1};
+}
+
+static inline SemaphoreHandle_t xSemaphoreCreateBinary(void) {
+    return new SemaphoreStub{false, 0};
 }
 
 static inline void vSemaphoreDelete(SemaphoreHandle_t xSemaphore) {
     delete xSemaphore;
 }
 
-static inline BaseType_t xSemaphoreTake(SemaphoreHandle_t /*xSemaphore*/, TickType_t /*xTicksToWait*/) {
+static inline BaseType_t xSemaphoreTake(SemaphoreHandle_t xSemaphore, TickType_t /*xTicksToWait*/) {
+    if (xSemaphore->isMutex) {
+        return pdPASS;
+    }
+    if (xSemaphore->count == 0) {
+        return pdFALSE;
+    }
+    xSemaphore->count--;
     return pdPASS;
 }
 
-static inline BaseType_t xSemaphoreGive(SemaphoreHandle_t /*xSemaphore*/) {
+static inline BaseType_t xSemaphoreGive(SemaphoreHandle_t xSemaphore) {
+    if (!xSemaphore->isMutex) {
+        xSemaphore->count = 1;
+    }
     return pdPASS;
 }
 
+static inline BaseType_t xSemaphoreGiveFromISR(SemaphoreHandle_t xSemaphore, BaseType_t* pxHigherPriorityTaskWoken) {
+    if (pxHigherPriorityTaskWoken) {
+        *pxHigherPriorityTaskWoken = pdFALSE;
+    }
+    return xSemaphoreGive(xSemaphore);
+}
+
 #ifdef __cplusplus
 }
 #endif
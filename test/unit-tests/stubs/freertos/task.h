@@ -8,6 +8,9 @@
 #ifdef __cplusplus
 #include <chrono>
 #include <thread>
+
+// Tasks do not run on the host; remembers the priority a task was last created or set with
+inline UBaseType_t g_stubTaskPriority = 0;
 #endif
 
 #ifdef __cplusplus
@@ -16,25 +19,52 @@ extern "C" {
 
 typedef void (*TaskFunction_t)(void*);
 
+#define tskNO_AFFINITY ((BaseType_t) 0x7FFFFFFF)
+
 static inline BaseType_t xTaskCreate(TaskFunction_t pxTaskCode,
                                      const char* /*pcName*/,
                                      const uint32_t /*usStackDepth*/,
                                      void* pvParameters,
-                                     UBaseType_t /*uxPriority*/,
+                                     UBaseType_t uxPriority,
                                      TaskHandle_t* pxCreatedTask) {
     // For host stubs, we do not create a real thread.
     // Simulate successful creation and optionally run the function synchronously in tests that depend on it.
     if (pxCreatedTask) {
         *pxCreatedTask = (TaskHandle_t) 0x1; // non-null handle
     }
+    g_stubTaskPriority = uxPriority;
     // Do NOT run pxTaskCode here to avoid unexpected blocking in tests.
     return pdPASS;
 }
 
+static inline BaseType_t xTaskCreatePinnedToCore(TaskFunction_t pxTaskCode,
+                                                 const char* pcName,
+                                                 const uint32_t usStackDepth,
+                                                 void* pvParameters,
+                                                 UBaseType_t uxPriority,
+                                                 TaskHandle_t* pxCreatedTask,
+                                                 const BaseType_t /*xCoreID*/) {
+    return xTaskCreate(pxTaskCode, pcName, usStackDepth, pvParameters, uxPriority, pxCreatedTask);
+}
+
 static inline void vTaskDelete(TaskHandle_t /*xTaskToDelete*/) {
     // No-op in host stub
 }
 
+static inline void vTaskPrioritySet(TaskHandle_t /*xTask*/, UBaseType_t uxNewPriority) {
+    g_stubTaskPriority = uxNewPriority;
+}
+
+static inline UBaseType_t uxTaskPriorityGet(TaskHandle_t /*xTask*/) {
+    return g_stubTaskPriority;
+}
+
+static inline TaskHandle_t xTaskGetCurrentTaskHandle(void) {
+    // Tests run outside any task: each host thread gets its own non-null handle
+    static thread_local char self;
+    return (TaskHandle_t) &self;
+}
+
 #ifdef __cplusplus
 }
 // vTaskDelay implementation needs C++ headers, so define outside extern "C"
@@ -42,6 +72,12 @@ static inline void vTaskDelay(const TickType_t xTicksToDelay) {
     // Approximate: ticks map to milliseconds via pdMS_TO_TICKS in stubs
     std::this_thread::sleep_for(std::chrono::milliseconds(xTicksToDelay));
 }
+
+static inline TickType_t xTaskGetTickCount(void) {
+    // One tick per millisecond, like vTaskDelay above
+    using namespace std::chrono;
+    return (TickType_t) duration_cast<milliseconds>(steady_clock::now().time_since_epoch()).count();
+}
 extern "C" {
 #endif
 
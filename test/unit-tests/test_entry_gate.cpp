@@ -49,6 +49,13 @@ void test_entry_full_cycle() {
     assert(controller.getState() == EntryGateState::OpeningBarrier);
     assert(gate.isOpen()); // Gate opening
 
+    // Ticket and barrier notifications published as one batch, in order
+    const auto& history = eventBus.history();
+    assert(history.size() == 3);
+    assert(history[1].type == EventType::TicketIssued);
+    assert(std::get<uint32_t>(history[1].payload) == 1);
+    assert(history[2].type == EventType::EntryBarrierOpened);
+
     // Step 2: Simulate barrier opened (timeout)
     controller.TEST_forceBarrierTimeout();
     assert(controller.getState() == EntryGateState::WaitingForCar);
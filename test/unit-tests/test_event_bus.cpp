@@ -0,0 +1,1208 @@
+/**
+ * @file test_event_bus.cpp
+ * @brief Unit tests for FreeRtosEventBus
+ *
+ * Runs the real event bus against the host FreeRTOS stubs (single-threaded
+ * FIFO queues, no event loop task) and drives it via processAllPending().
+ */
+
+#include "EventNameLookup.h"
+#include "FreeRtosEventBus.h"
+#include "esp_timer.h"
+#include <algorithm>
+#include <cassert>
+#include <cstdio>
+#include <cstring>
+#include <memory>
+#include <thread>
+#include <vector>
+
+/**
+ * @brief Test events are delivered only to handlers of their own type
+ */
+void test_dispatch_by_type() {
+    printf("Test: Dispatch by event type\n");
+
+    FreeRtosEventBus bus(8);
+    int pressed = 0;
+    int blocked = 0;
+
+    bus.subscribe(EventType::EntryButtonPressed, [&pressed](const Event&) { pressed++; });
+    bus.subscribe(EventType::EntryLightBarrierBlocked, [&blocked](const Event&) { blocked++; });
+
+    bus.publish(Event(EventType::EntryButtonPressed));
+    bus.publish(Event(EventType::EntryButtonPressed));
+    bus.publish(Event(EventType::EntryLightBarrierBlocked));
+    bus.publish(Event(EventType::ExitLightBarrierBlocked)); // No subscriber
+    bus.processAllPending();
+
+    assert(pressed == 2);
+    assert(blocked == 1);
+
+    printf("  ✓ Handlers receive only their event type\n\n");
+}
+
+/**
+ * @brief Test handlers of one type run in subscription order
+ */
+void test_dispatch_order() {
+    printf("Test: Dispatch order within a slot\n");
+
+    FreeRtosEventBus bus(8);
+    std::vector<int> calls;
+
+    bus.subscribe(EventType::TicketIssued, [&calls](const Event&) { calls.push_back(1); });
+    bus.subscribe(EventType::TicketIssued, [&calls](const Event&) { calls.push_back(2); });
+    bus.subscribe(EventType::TicketIssued, [&calls](const Event&) { calls.push_back(3); });
+
+    bus.publish(Event(EventType::TicketIssued, 0, uint32_t{7}));
+    bus.processAllPending();
+
+    assert((calls == std::vector<int>{1, 2, 3}));
+
+    printf("  ✓ Handlers called in subscription order\n\n");
+}
+
+/**
+ * @brief Test payload and timestamp survive the queue
+ */
+void test_publish_preserves_event() {
+    printf("Test: Publish preserves payload and stamps time\n");
+
+    FreeRtosEventBus bus(8);
+    Event received;
+
+    bus.subscribe(EventType::CarEnteredParking, [&received](const Event& e) { received = e; });
+
+    bus.publish(Event(EventType::CarEnteredParking, 0, uint32_t{42}));
+    bus.processAllPending();
+
+    assert(received.type == EventType::CarEnteredParking);
+    assert(std::get<uint32_t>(received.payload) == 42);
+    assert(received.timestamp != 0);
+
+    printf("  ✓ Payload delivered, timestamp set\n\n");
+}
+
+/**
+ * @brief Test the dispatch table covers every event type
+ */
+void test_table_covers_all_types() {
+    printf("Test: Dispatch table covers all event types\n");
+
+    FreeRtosEventBus bus(EVENT_TYPE_COUNT, EVENT_TYPE_COUNT);
+    std::vector<int> counts(EVENT_TYPE_COUNT, 0);
+
+    for (size_t i = 0; i < EVENT_TYPE_COUNT; i++) {
+        bus.subscribe(static_cast<EventType>(i), [&counts, i](const Event&) { counts[i]++; });
+    }
+    for (size_t i = 0; i < EVENT_TYPE_COUNT; i++) {
+        bus.publish(Event(static_cast<EventType>(i)));
+    }
+    bus.processAllPending();
+
+    for (size_t i = 0; i < EVENT_TYPE_COUNT; i++) {
+        assert(counts[i] == 1);
+    }
+
+    printf("  ✓ %u event types dispatched\n\n", (unsigned) EVENT_TYPE_COUNT);
+}
+
+/**
+ * @brief Test subscriptions after seal() go through a table swap
+ */
+void test_late_subscribe_after_seal() {
+    printf("Test: Late subscribe after seal\n");
+
+    FreeRtosEventBus bus(8);
+    int early = 0;
+    int late = 0;
+
+    bus.subscribe(EventType::EntryButtonPressed, [&early](const Event&) { early++; });
+    assert(!bus.isSealed());
+    bus.seal();
+    assert(bus.isSealed());
+
+    bus.publish(Event(EventType::EntryButtonPressed));
+    bus.processAllPending();
+    assert(early == 1 && late == 0);
+
+    bus.subscribe(EventType::EntryButtonPressed, [&late](const Event&) { late++; });
+    bus.publish(Event(EventType::EntryButtonPressed));
+    bus.processAllPending();
+    assert(early == 2 && late == 1);
+
+    printf("  ✓ Early and late subscribers both receive events\n\n");
+}
+
+/**
+ * @brief Test a handler may subscribe while a sealed dispatch is running
+ */
+void test_subscribe_from_handler_after_seal() {
+    printf("Test: Subscribe from handler after seal\n");
+
+    FreeRtosEventBus bus(8);
+    int added = 0;
+    bool subscribed = false;
+
+    bus.subscribe(EventType::TicketIssued, [&](const Event&) {
+        if (!subscribed) {
+            subscribed = true;
+            bus.subscribe(EventType::TicketIssued, [&added](const Event&) { added++; });
+        }
+    });
+    bus.seal();
+
+    bus.publish(Event(EventType::TicketIssued));
+    bus.processAllPending();
+    assert(added == 0); // Current dispatch keeps iterating the old table
+
+    bus.publish(Event(EventType::TicketIssued));
+    bus.processAllPending();
+    assert(added == 1);
+
+    printf("  ✓ New handler visible from the next event on\n\n");
+}
+
+/**
+ * @brief Test subscribing from a handler before seal, on the loop and on a worker
+ */
+void test_subscribe_from_handler_unsealed() {
+    printf("Test: Subscribe from handler before seal\n");
+
+    FreeRtosEventBus bus(8);
+    int added = 0;
+    int asyncAdded = 0;
+    bool subscribed = false;
+    bool asyncSubscribed = false;
+
+    bus.subscribe(EventType::TicketIssued, [&](const Event&) {
+        if (!subscribed) {
+            subscribed = true;
+            bus.subscribe(EventType::TicketIssued, [&added](const Event&) { added++; });
+        }
+    });
+    bus.subscribe(EventType::TicketIssued, [&](const Event&) {
+        if (!asyncSubscribed) {
+            asyncSubscribed = true;
+            bus.subscribe(EventType::TicketIssued, [&asyncAdded](const Event&) { asyncAdded++; },
+                          SubscribeOptions{.async = true});
+        }
+    }, SubscribeOptions{.async = true});
+
+    bus.publish(Event(EventType::TicketIssued));
+    bus.processAllPending();
+    assert(bus.processAsyncPending() == 1);
+    assert(added == 0 && asyncAdded == 0); // Dispatch in progress keeps its table snapshot
+
+    bus.publish(Event(EventType::TicketIssued));
+    bus.processAllPending();
+    assert(bus.processAsyncPending() == 1);
+    assert(added == 1 && asyncAdded == 1);
+
+    printf("  ✓ Handlers run without the table lock, new handler visible from the next event on\n\n");
+}
+
+/**
+ * @brief Test EventHandler copies, moves and destroys non-trivial captures
+ */
+void test_event_handler_lifetime() {
+    printf("Test: EventHandler capture lifetime\n");
+
+    auto counter = std::make_shared<int>(0);
+    {
+        EventHandler a = [counter](const Event&) { (*counter)++; };
+        assert(counter.use_count() == 2);
+
+        EventHandler b = a; // Copy
+        assert(counter.use_count() == 3);
+
+        EventHandler c = std::move(a); // Move leaves source empty
+        assert(!a);
+        assert(counter.use_count() == 3);
+
+        b(Event(EventType::TicketIssued));
+        c(Event(EventType::TicketIssued));
+        assert(*counter == 2);
+
+        b = nullptr;
+        assert(counter.use_count() == 2);
+    }
+    assert(counter.use_count() == 1);
+
+    static_assert(sizeof(EventHandler) <= EVENT_HANDLER_CAPACITY + 2 * sizeof(void*));
+
+    printf("  ✓ Captures copied, moved and released\n\n");
+}
+
+/**
+ * @brief Test publishBatch queues all events or none
+ */
+void test_publish_batch_all_or_nothing() {
+    printf("Test: publishBatch is all-or-nothing\n");
+
+    FreeRtosEventBus bus(4, 4);
+    bus.setOverflowPolicy(EventType::TicketIssued, OverflowPolicy::DropOldest);
+    std::vector<EventType> received;
+    for (auto type : {EventType::TicketIssued, EventType::EntryBarrierOpened, EventType::CapacityFull}) {
+        bus.subscribe(type, [&received](const Event& e) { received.push_back(e.type); });
+    }
+
+    bus.publish(Event(EventType::CapacityFull));
+    bus.publish(Event(EventType::CapacityFull));
+    bus.publish(Event(EventType::CapacityFull));
+
+    // Only one slot left - batch of two must be rejected completely
+    const Event chain[] = {Event(EventType::TicketIssued, 0, uint32_t{1}), Event(EventType::EntryBarrierOpened)};
+    assert(!bus.publishBatch(chain));
+    bus.processAllPending();
+    assert(received.size() == 3);
+
+    // Every event of the rejected batch counts as dropped; DropOldest evicted nothing for it
+    EventBusStats stats = bus.getStats();
+    assert(stats.types[eventTypeIndex(EventType::TicketIssued)].published == 1);
+    assert(stats.types[eventTypeIndex(EventType::TicketIssued)].dropped == 1);
+    assert(stats.types[eventTypeIndex(EventType::EntryBarrierOpened)].dropped == 1);
+    assert(stats.types[eventTypeIndex(EventType::CapacityFull)].dropped == 0);
+
+    // Queue drained - batch fits and keeps its order
+    received.clear();
+    assert(bus.publishBatch(chain));
+    bus.processAllPending();
+    assert((received == std::vector<EventType>{EventType::TicketIssued, EventType::EntryBarrierOpened}));
+
+    printf("  ✓ Oversized batch rejected, fitting batch delivered in order\n\n");
+}
+
+/**
+ * @brief Test draining more events than one batch keeps FIFO order
+ */
+void test_batch_drain_order() {
+    printf("Test: Batch drain keeps FIFO order\n");
+
+    const size_t eventCount = FreeRtosEventBus::EVENT_LOOP_BATCH_SIZE * 2 + 3;
+    FreeRtosEventBus bus(eventCount, eventCount);
+    std::vector<uint32_t> received;
+    bus.subscribe(EventType::TicketIssued, [&received](const Event& e) { received.push_back(std::get<uint32_t>(e.payload)); });
+    bus.seal();
+
+    for (uint32_t i = 0; i < eventCount; i++) {
+        bus.publish(Event(EventType::TicketIssued, 0, i));
+    }
+    bus.publish(Event(EventType::TicketIssued, 0, uint32_t{999})); // Queue full - dropped
+    bus.processAllPending();
+
+    assert(received.size() == eventCount);
+    for (uint32_t i = 0; i < eventCount; i++) {
+        assert(received[i] == i);
+    }
+
+    // Slots released by draining can be reused
+    bus.publish(Event(EventType::TicketIssued, 0, uint32_t{1000}));
+    bus.processAllPending();
+    assert(received.back() == 1000);
+
+    printf("  ✓ %u events drained in order across batches\n\n", (unsigned) eventCount);
+}
+
+/**
+ * @brief Test a low lane flood neither drops nor delays sensor events
+ */
+void test_priority_lanes() {
+    printf("Test: Priority lanes\n");
+
+    FreeRtosEventBus bus(4, 4);
+    assert(bus.queueCapacity(EventPriority::High) == 4);
+    assert(bus.queueCapacity(EventPriority::Low) == 4);
+
+    std::vector<EventType> received;
+    for (auto type : {EventType::CarEnteredParking, EventType::EntryLightBarrierBlocked,
+                      EventType::EntryLightBarrierCleared}) {
+        bus.subscribe(type, [&received](const Event& e) { received.push_back(e.type); });
+    }
+    bus.seal();
+
+    // Flood the low lane past its capacity
+    for (int i = 0; i < 10; i++) {
+        bus.publish(Event(EventType::CarEnteredParking));
+    }
+    bus.publish(Event(EventType::EntryLightBarrierBlocked));
+    bus.publish(Event(EventType::EntryLightBarrierCleared));
+
+    // Sensor events are served first, then the four low lane events that fit
+    Event out;
+    assert(bus.waitForEvent(out, 0) && out.type == EventType::EntryLightBarrierBlocked);
+    bus.processAllPending();
+    assert((received == std::vector<EventType>{EventType::EntryLightBarrierBlocked,
+                                                EventType::EntryLightBarrierCleared,
+                                                EventType::CarEnteredParking, EventType::CarEnteredParking,
+                                                EventType::CarEnteredParking, EventType::CarEnteredParking}));
+
+    // Both lanes fully usable again
+    assert(!bus.waitForEvent(out, 10));
+    for (int i = 0; i < 4; i++) {
+        bus.publish(Event(EventType::EntryLightBarrierBlocked));
+    }
+    bus.processAllPending();
+    assert(received.size() == 10);
+
+    printf("  ✓ Sensor events queued and dispatched ahead of a low lane flood\n\n");
+}
+
+/**
+ * @brief Test DropNewest counts drops and high-watermarks
+ */
+void test_overflow_drop_newest() {
+    printf("Test: Overflow policy DropNewest\n");
+
+    FreeRtosEventBus bus(2, 2);
+    std::vector<uint32_t> received;
+    bus.subscribe(EventType::TicketIssued, [&received](const Event& e) { received.push_back(std::get<uint32_t>(e.payload)); });
+    assert(bus.getOverflowPolicy(EventType::TicketIssued) == OverflowPolicy::DropNewest);
+
+    for (uint32_t i = 1; i <= 3; i++) {
+        bus.publish(Event(EventType::TicketIssued, 0, i));
+    }
+
+    EventBusStats stats = bus.getStats();
+    const EventTypeStats& ticket = stats.types[eventTypeIndex(EventType::TicketIssued)];
+    assert(ticket.published == 3 && ticket.dropped == 1);
+    assert(ticket.queued == 2 && ticket.highWatermark == 2);
+    assert(stats.lanes[static_cast<size_t>(EventPriority::Low)].highWatermark == 2);
+    assert(stats.lanes[static_cast<size_t>(EventPriority::High)].highWatermark == 0);
+
+    bus.processAllPending();
+    assert((received == std::vector<uint32_t>{1, 2}));
+    stats = bus.getStats();
+    assert(stats.types[eventTypeIndex(EventType::TicketIssued)].queued == 0);
+    assert(stats.lanes[static_cast<size_t>(EventPriority::Low)].queued == 0);
+
+    bus.resetStats();
+    stats = bus.getStats();
+    assert(stats.types[eventTypeIndex(EventType::TicketIssued)].published == 0);
+    assert(stats.types[eventTypeIndex(EventType::TicketIssued)].highWatermark == 0);
+    assert(stats.lanes[static_cast<size_t>(EventPriority::Low)].highWatermark == 0);
+
+    printf("  ✓ Newest event dropped and counted, peaks recorded and reset\n\n");
+}
+
+/**
+ * @brief Test DropOldest evicts queued events of the same lane
+ */
+void test_overflow_drop_oldest() {
+    printf("Test: Overflow policy DropOldest\n");
+
+    FreeRtosEventBus bus(2, 2);
+    bus.setOverflowPolicy(OverflowPolicy::DropOldest);
+    std::vector<uint32_t> received;
+    bus.subscribe(EventType::TicketIssued, [&received](const Event& e) { received.push_back(std::get<uint32_t>(e.payload)); });
+
+    for (uint32_t i = 1; i <= 4; i++) {
+        bus.publish(Event(EventType::TicketIssued, 0, i));
+    }
+    bus.processAllPending();
+
+    assert((received == std::vector<uint32_t>{3, 4}));
+    EventTypeStats ticket = bus.getStats().types[eventTypeIndex(EventType::TicketIssued)];
+    assert(ticket.published == 4 && ticket.dropped == 2 && ticket.queued == 0);
+
+    printf("  ✓ Oldest events evicted, newest delivered\n\n");
+}
+
+/**
+ * @brief Test BlockWithTimeout gives up after the block timeout
+ */
+void test_overflow_block_with_timeout() {
+    printf("Test: Overflow policy BlockWithTimeout\n");
+
+    FreeRtosEventBus bus(1, 1);
+    bus.setOverflowPolicy(EventType::EntryLightBarrierBlocked, OverflowPolicy::BlockWithTimeout);
+    bus.setBlockTimeout(2);
+
+    bus.publish(Event(EventType::EntryLightBarrierBlocked));
+    bus.publish(Event(EventType::EntryLightBarrierBlocked)); // No consumer frees the slot
+    EventTypeStats blocked = bus.getStats().types[eventTypeIndex(EventType::EntryLightBarrierBlocked)];
+    assert(blocked.published == 2 && blocked.dropped == 1 && blocked.queued == 1);
+
+    // ISR publishes never block
+    assert(!bus.publishFromISR(Event(EventType::EntryLightBarrierBlocked)));
+
+    printf("  ✓ Event dropped after timeout, ISR publish does not wait\n\n");
+}
+
+/**
+ * @brief Test OverwriteLatest keeps only the newest parked event
+ */
+void test_overflow_overwrite_latest() {
+    printf("Test: Overflow policy OverwriteLatest\n");
+
+    FreeRtosEventBus bus(2, 2);
+    bus.setOverflowPolicy(EventType::CapacityAvailable, OverflowPolicy::OverwriteLatest);
+    std::vector<Event> received;
+    for (auto type : {EventType::TicketIssued, EventType::CapacityAvailable}) {
+        bus.subscribe(type, [&received](const Event& e) { received.push_back(e); });
+    }
+
+    bus.publish(Event(EventType::TicketIssued, 0, uint32_t{1}));
+    bus.publish(Event(EventType::TicketIssued, 0, uint32_t{2}));
+    bus.publish(Event(EventType::CapacityAvailable, 0, uint32_t{10})); // Lane full - parked
+    bus.publish(Event(EventType::CapacityAvailable, 0, uint32_t{11})); // Replaces parked event
+    bus.publish(Event(EventType::CapacityAvailable, 0, uint32_t{12}));
+    bus.processAllPending();
+
+    assert(received.size() == 3);
+    assert(received[2].type == EventType::CapacityAvailable);
+    assert(std::get<uint32_t>(received[2].payload) == 12);
+    EventTypeStats capacity = bus.getStats().types[eventTypeIndex(EventType::CapacityAvailable)];
+    assert(capacity.published == 3 && capacity.dropped == 2 && capacity.queued == 0);
+
+    // With room in the lane the event is queued normally
+    received.clear();
+    bus.publish(Event(EventType::CapacityAvailable, 0, uint32_t{13}));
+    bus.processAllPending();
+    assert(received.size() == 1 && std::get<uint32_t>(received[0].payload) == 13);
+
+    printf("  ✓ Latest parked event delivered after queued ones\n\n");
+}
+
+/**
+ * @brief Test flickering light barrier events are coalesced per source
+ */
+void test_coalescing_level_events() {
+    printf("Test: Coalescing of level-style events\n");
+
+    FreeRtosEventBus bus(4, 4);
+    bus.setCoalescing(true);
+    std::vector<EventType> received;
+    for (auto type : {EventType::EntryButtonPressed, EventType::EntryLightBarrierBlocked,
+                      EventType::EntryLightBarrierCleared, EventType::ExitLightBarrierBlocked}) {
+        bus.subscribe(type, [&received](const Event& e) { received.push_back(e.type); });
+    }
+
+    // Flicker run of one source takes a single slot and keeps its position
+    bus.publish(Event(EventType::EntryButtonPressed));
+    for (int i = 0; i < 3; i++) {
+        bus.publish(Event(EventType::EntryLightBarrierBlocked));
+        bus.publish(Event(EventType::EntryLightBarrierCleared));
+    }
+    bus.publish(Event(EventType::ExitLightBarrierBlocked));
+    bus.publish(Event(EventType::EntryButtonPressed));
+    assert(bus.getStats().lanes[static_cast<size_t>(EventPriority::High)].queued == 4);
+
+    bus.processAllPending();
+    assert((received == std::vector<EventType>{EventType::EntryButtonPressed, EventType::EntryLightBarrierBlocked,
+                                                EventType::EntryLightBarrierCleared, EventType::ExitLightBarrierBlocked,
+                                                EventType::EntryButtonPressed}));
+
+    EventBusStats stats = bus.getStats();
+    assert(stats.types[eventTypeIndex(EventType::EntryLightBarrierBlocked)].coalesced == 2);
+    assert(stats.types[eventTypeIndex(EventType::EntryLightBarrierCleared)].coalesced == 3);
+    assert(stats.types[eventTypeIndex(EventType::EntryLightBarrierBlocked)].dropped == 0);
+
+    // Run ending on its starting level dispatches that level once
+    received.clear();
+    bus.publish(Event(EventType::EntryLightBarrierBlocked));
+    bus.publish(Event(EventType::EntryLightBarrierCleared));
+    bus.publish(Event(EventType::EntryLightBarrierBlocked));
+    Event out;
+    assert(bus.waitForEvent(out, 0) && out.type == EventType::EntryLightBarrierBlocked);
+    assert((received == std::vector<EventType>{EventType::EntryLightBarrierBlocked}));
+
+    // Dispatched token frees the source for the next edge
+    bus.publish(Event(EventType::EntryLightBarrierCleared));
+    bus.processAllPending();
+    assert(received.back() == EventType::EntryLightBarrierCleared);
+
+    // Batched edges merge into the run of a published one instead of queueing behind its token
+    received.clear();
+    bus.publish(Event(EventType::EntryLightBarrierBlocked));
+    const Event flicker[] = {Event(EventType::EntryLightBarrierCleared), Event(EventType::EntryLightBarrierBlocked),
+                             Event(EventType::EntryLightBarrierCleared)};
+    assert(bus.publishBatch(flicker));
+    assert(bus.getStats().lanes[static_cast<size_t>(EventPriority::High)].queued == 1);
+    bus.processAllPending();
+    assert((received == std::vector<EventType>{EventType::EntryLightBarrierBlocked,
+                                                EventType::EntryLightBarrierCleared}));
+
+    printf("  ✓ Flicker merged into first and last level, order with other types kept\n\n");
+}
+
+/**
+ * @brief Test ISR ring edges reach subscribers with their interrupt timestamp
+ */
+void test_isr_event_ring() {
+    printf("Test: ISR event ring ingestion\n");
+
+    FreeRtosEventBus bus(4, 4);
+    IsrEventRing* ring = bus.createIsrEventRing(EventType::EntryLightBarrierBlocked, EventType::EntryLightBarrierCleared);
+    assert(ring != nullptr);
+
+    std::vector<Event> received;
+    for (auto type : {EventType::EntryLightBarrierBlocked, EventType::EntryLightBarrierCleared, EventType::TicketIssued}) {
+        bus.subscribe(type, [&received](const Event& e) { received.push_back(e); });
+    }
+
+    // Ring edges are dispatched ahead of queued events, with the ISR timestamp
+    auto edgeTime = static_cast<uint32_t>(esp_timer_get_time()) - 500;
+    bus.publish(Event(EventType::TicketIssued));
+    assert(ring->pushFromISR(false, edgeTime));
+    assert(ring->pushFromISR(true, edgeTime + 100));
+    bus.processAllPending();
+
+    assert(received.size() == 3);
+    assert(received[0].type == EventType::EntryLightBarrierBlocked);
+    assert(static_cast<uint32_t>(received[0].timestamp) == edgeTime);
+    assert(received[1].type == EventType::EntryLightBarrierCleared);
+    assert(static_cast<uint32_t>(received[1].timestamp) == edgeTime + 100);
+    assert(received[2].type == EventType::TicketIssued);
+
+    // Full ring drops and counts the newest edges
+    received.clear();
+    for (uint32_t i = 0; i < IsrEventRing::CAPACITY + 2; i++) {
+        (void) ring->pushFromISR(i % 2 != 0, edgeTime + i);
+    }
+    bus.processAllPending();
+    assert(received.size() == IsrEventRing::CAPACITY);
+    EventBusStats stats = bus.getStats();
+    assert(stats.types[eventTypeIndex(EventType::EntryLightBarrierBlocked)].dropped == 1);
+    assert(stats.types[eventTypeIndex(EventType::EntryLightBarrierCleared)].dropped == 1);
+    assert(stats.types[eventTypeIndex(EventType::EntryLightBarrierBlocked)].published == 1 + IsrEventRing::CAPACITY / 2 + 1);
+
+    // Limited number of rings
+    for (size_t i = 1; i < FreeRtosEventBus::MAX_ISR_SOURCES; i++) {
+        assert(bus.createIsrEventRing(EventType::ExitLightBarrierBlocked, EventType::ExitLightBarrierCleared) != nullptr);
+    }
+    assert(bus.createIsrEventRing(EventType::ExitLightBarrierBlocked, EventType::ExitLightBarrierCleared) == nullptr);
+
+    printf("  ✓ Edges dispatched first with ISR timestamps, overruns counted\n\n");
+}
+
+/**
+ * @brief Test a flickering ISR ring is reduced to first and last level
+ */
+void test_isr_event_ring_coalescing() {
+    printf("Test: ISR event ring coalescing\n");
+
+    FreeRtosEventBus bus(4, 4);
+    bus.setCoalescing(true);
+    IsrEventRing* ring = bus.createIsrEventRing(EventType::ExitLightBarrierBlocked, EventType::ExitLightBarrierCleared);
+    std::vector<EventType> received;
+    for (auto type : {EventType::ExitLightBarrierBlocked, EventType::ExitLightBarrierCleared}) {
+        bus.subscribe(type, [&received](const Event& e) { received.push_back(e.type); });
+    }
+
+    for (int i = 0; i < 6; i++) {
+        (void) ring->push(i % 2 != 0, 0);
+    }
+    bus.processAllPending();
+    assert((received == std::vector<EventType>{EventType::ExitLightBarrierBlocked, EventType::ExitLightBarrierCleared}));
+    EventBusStats stats = bus.getStats();
+    assert(stats.types[eventTypeIndex(EventType::ExitLightBarrierBlocked)].coalesced == 2);
+    assert(stats.types[eventTypeIndex(EventType::ExitLightBarrierCleared)].coalesced == 2);
+
+    // Single-event receive leaves the rest of the run in the ring
+    received.clear();
+    (void) ring->push(false, 0);
+    (void) ring->push(true, 0);
+    Event out;
+    assert(bus.waitForEvent(out, 0) && out.type == EventType::ExitLightBarrierBlocked);
+    assert(bus.waitForEvent(out, 0) && out.type == EventType::ExitLightBarrierCleared);
+    assert(received.size() == 2);
+
+    // Button presses are not level sources: every edge is kept
+    IsrEventRing* button = bus.createIsrEventRing(EventType::EntryButtonPressed, EventType::EntryButtonReleased);
+    for (auto type : {EventType::EntryButtonPressed, EventType::EntryButtonReleased}) {
+        bus.subscribe(type, [&received](const Event& e) { received.push_back(e.type); });
+    }
+    received.clear();
+    for (int i = 0; i < 4; i++) {
+        (void) button->push(i % 2 != 0, 0);
+    }
+    bus.processAllPending();
+    assert((received == std::vector<EventType>{EventType::EntryButtonPressed, EventType::EntryButtonReleased,
+                                               EventType::EntryButtonPressed, EventType::EntryButtonReleased}));
+    assert(bus.getStats().types[eventTypeIndex(EventType::EntryButtonPressed)].coalesced == 0);
+
+    printf("  ✓ Edge run dispatched as first and last level, button presses kept\n\n");
+}
+
+/**
+ * @brief Test the event loop can be stopped and restarted
+ */
+void test_event_loop_start_stop() {
+    printf("Test: Event loop start/stop\n");
+
+    FreeRtosEventBus bus(4, 4);
+    int pressed = 0;
+    bus.subscribe(EventType::EntryButtonPressed, [&pressed](const Event&) { pressed++; });
+
+    assert(!bus.isEventLoopRunning());
+    bus.startEventLoop();
+    assert(bus.isEventLoopRunning());
+    bus.stopEventLoop();
+    assert(!bus.isEventLoopRunning());
+
+    // Stop wakeup must not leave the bus unusable for direct receives
+    bus.publish(Event(EventType::EntryButtonPressed));
+    Event out;
+    assert(bus.waitForEvent(out, 10) && pressed == 1);
+    assert(!bus.waitForEvent(out, 10));
+
+    bus.startEventLoop();
+    assert(bus.isEventLoopRunning());
+
+    printf("  ✓ Loop stopped, restarted and joined on destruction\n\n");
+}
+
+/**
+ * @brief Test the loop task priority follows queue depth with hysteresis
+ */
+void test_priority_boost() {
+    printf("Test: Queue-depth priority boost\n");
+
+    FreeRtosEventBus bus(8, 8);
+    bus.setPriorityBoost(PriorityBoostConfig{.highWater = 4, .lowWater = 4, .priority = 9});
+    assert(bus.getPriorityBoost().lowWater == 3); // Clamped below highWater
+
+    // No loop task, nothing to boost
+    for (int i = 0; i < 4; i++) {
+        bus.publish(Event(EventType::EntryButtonPressed));
+    }
+    assert(bus.getStats().boost.boosts == 0);
+    bus.processAllPending();
+
+    bus.startEventLoop(4096, 5); // Host stub: task is created but does not run
+    assert(uxTaskPriorityGet(nullptr) == 5);
+    for (int i = 0; i < 3; i++) {
+        bus.publish(Event(EventType::EntryButtonPressed));
+    }
+    assert(uxTaskPriorityGet(nullptr) == 5);
+    bus.publish(Event(EventType::TicketIssued, 0, uint32_t{1})); // Both lanes count
+    assert(uxTaskPriorityGet(nullptr) == 9 && bus.getStats().boost.active);
+    bus.publish(Event(EventType::EntryButtonPressed));
+    vTaskDelay(pdMS_TO_TICKS(2));
+
+    // Stays boosted until the backlog is down to lowWater
+    Event out;
+    assert(bus.waitForEvent(out, 0));
+    assert(uxTaskPriorityGet(nullptr) == 9);
+    assert(bus.waitForEvent(out, 0));
+    assert(uxTaskPriorityGet(nullptr) == 5);
+
+    EventBusStats stats = bus.getStats();
+    assert(!stats.boost.active && stats.boost.boosts == 1 && stats.boost.boostedUs >= 2000);
+
+    // Boost in progress when the loop stops is closed
+    const Event batch[] = {Event(EventType::EntryButtonPressed), Event(EventType::EntryButtonPressed)};
+    assert(bus.publishBatch(batch));
+    assert(bus.getStats().boost.active && bus.getStats().boost.boosts == 2);
+    bus.stopEventLoop();
+    assert(!bus.getStats().boost.active);
+
+    bus.resetStats();
+    assert(bus.getStats().boost.boosts == 0 && bus.getStats().boost.boostedUs == 0);
+
+    printf("  ✓ Boosted at the high-water mark, restored at the low-water mark\n\n");
+}
+
+/**
+ * @brief Test flight recorder keeps published, dropped and dispatched events
+ */
+void test_event_trace_recorder() {
+    printf("Test: Event flight recorder\n");
+
+    FreeRtosEventBus bus(2, 1);
+    bus.subscribe(EventType::TicketIssued, [](const Event&) {});
+
+    bus.publish(Event(EventType::TicketIssued, 1000, static_cast<uint32_t>(7)));
+    bus.publish(Event(EventType::TicketIssued, 2000, static_cast<uint32_t>(8))); // Lane full: dropped
+    bus.processAllPending();
+
+    TraceEntry entries[EventTraceRecorder::CAPACITY];
+    size_t count = bus.getTraceRecorder().snapshot(entries, EventTraceRecorder::CAPACITY);
+    assert(count == 4);
+    assert(entries[0].kind == TraceKind::Published && entries[0].payload == 7 && entries[0].publishTime == 1000);
+    assert(entries[1].kind == TraceKind::Published && entries[1].payload == 8);
+    assert(entries[2].kind == TraceKind::Dropped && entries[2].payload == 8 && entries[2].publishTime == 2000);
+    assert(entries[3].kind == TraceKind::Dispatched && entries[3].payload == 7);
+    assert(entries[3].type == static_cast<uint8_t>(EventType::TicketIssued));
+    assert(entries[3].dispatchTime != 0);
+
+    // Ring keeps only the newest CAPACITY entries, oldest first
+    EventTraceRecorder recorder;
+    PackedEvent packed{};
+    for (uint32_t i = 0; i < EventTraceRecorder::CAPACITY + 10; i++) {
+        packed.payload = i;
+        recorder.record(TraceKind::Published, packed);
+    }
+    assert(recorder.recordedCount() == EventTraceRecorder::CAPACITY + 10);
+    count = recorder.snapshot(entries, EventTraceRecorder::CAPACITY);
+    assert(count == EventTraceRecorder::CAPACITY);
+    assert(entries[0].payload == 10 && entries[count - 1].payload == EventTraceRecorder::CAPACITY + 9);
+    assert(recorder.snapshot(entries, 3) == 3 && entries[0].payload == EventTraceRecorder::CAPACITY + 7);
+
+    recorder.clear();
+    assert(recorder.snapshot(entries, EventTraceRecorder::CAPACITY) == 0);
+
+    printf("  ✓ Published, dropped and dispatched entries recorded, ring wraps to newest\n\n");
+}
+
+/**
+ * @brief Test latency histograms and percentiles
+ */
+void test_latency_histogram() {
+    printf("Test: Publish-to-dispatch latency histograms\n");
+
+    LatencyHistogram histogram;
+    assert(histogram.getStats().count == 0 && histogram.getStats().p99 == 0);
+    for (uint32_t i = 0; i < 90; i++) {
+        histogram.record(10); // Bucket [8, 16)
+    }
+    for (uint32_t i = 0; i < 9; i++) {
+        histogram.record(100); // Bucket [64, 128)
+    }
+    histogram.record(5000);
+
+    LatencyStats stats = histogram.getStats();
+    assert(stats.count == 100 && stats.max == 5000);
+    assert(stats.p50 == 15 && stats.p95 == 127 && stats.p99 == 127);
+    assert(histogram.bucketCount(4) == 90 && histogram.bucketCount(7) == 9);
+
+    histogram.record(0);
+    histogram.record(UINT32_MAX);
+    assert(histogram.bucketCount(0) == 1 && histogram.bucketCount(LatencyHistogram::BUCKET_COUNT - 1) == 1);
+    histogram.reset();
+    assert(histogram.getStats().count == 0 && histogram.getStats().max == 0);
+
+    // Bus measures from Event::timestamp to dispatch
+    FreeRtosEventBus bus(4, 4);
+    bus.subscribe(EventType::TicketIssued, [](const Event&) {});
+    auto publishTime = static_cast<uint64_t>(esp_timer_get_time()) - 2000;
+    bus.publish(Event(EventType::TicketIssued, publishTime, static_cast<uint32_t>(1)));
+    bus.publish(Event(EventType::TicketIssued));
+    bus.processAllPending();
+
+    stats = bus.getLatencyStats(EventType::TicketIssued);
+    assert(stats.count == 2);
+    assert(stats.max >= 2000 && stats.p99 >= 2000);
+    assert(bus.getLatencyStats(EventType::CapacityFull).count == 0);
+
+    bus.resetStats();
+    assert(bus.getLatencyStats(EventType::TicketIssued).count == 0);
+
+    printf("  ✓ Log2 buckets, percentiles and per-type bus latency\n\n");
+}
+
+/**
+ * @brief Test handler run time profiling and budget overruns
+ */
+void test_handler_profiling() {
+    printf("Test: Handler run time profiling\n");
+
+    FreeRtosEventBus bus(4, 4);
+    bus.subscribe(EventType::TicketIssued, [](const Event&) {}, SubscribeOptions{"fast", 100000});
+    bus.subscribe(EventType::TicketIssued, [](const Event&) {
+        int64_t start = esp_timer_get_time();
+        while (esp_timer_get_time() - start < 2000) {
+        }
+    }, SubscribeOptions{"slow", 500});
+    bus.subscribe(EventType::CapacityFull, [](const Event&) {});
+
+    bus.publish(Event(EventType::TicketIssued));
+    bus.publish(Event(EventType::TicketIssued));
+    bus.processAllPending();
+
+    std::vector<HandlerStats> handlers = bus.getHandlerStats();
+    assert(handlers.size() == 3);
+    assert(strcmp(handlers[0].name, "fast") == 0 && handlers[0].calls == 2 && handlers[0].overruns == 0);
+    assert(strcmp(handlers[1].name, "slow") == 0 && handlers[1].calls == 2 && handlers[1].overruns == 2);
+    assert(handlers[1].maxUs >= 2000 && handlers[1].avgUs >= 2000 && handlers[1].budgetUs == 500);
+    assert(handlers[2].name == nullptr && handlers[2].type == EventType::CapacityFull && handlers[2].calls == 0);
+    assert(bus.getBudgetOverruns() == 2);
+
+    // Profiles survive the copy-on-write table swap of late subscriptions
+    bus.seal();
+    bus.subscribe(EventType::TicketIssued, [](const Event&) {}, SubscribeOptions{"late", 0});
+    bus.publish(Event(EventType::TicketIssued));
+    bus.processAllPending();
+    handlers = bus.getHandlerStats();
+    assert(handlers.size() == 4 && handlers[1].calls == 3 && handlers[3].calls == 1);
+
+    bus.resetStats();
+    assert(bus.getHandlerStats()[1].calls == 0 && bus.getBudgetOverruns() == 0);
+
+    printf("  ✓ Run times and overruns counted per handler\n\n");
+}
+
+/**
+ * @brief Test async subscribers run from their worker queue, not inline
+ */
+void test_async_subscribers() {
+    printf("Test: Async subscribers on a worker\n");
+
+    FreeRtosEventBus bus(4, 4);
+    std::vector<uint32_t> inlineReceived;
+    std::vector<uint32_t> asyncReceived;
+    std::vector<uint32_t> slowReceived;
+    bus.subscribe(EventType::TicketIssued, [&](const Event& e) { inlineReceived.push_back(std::get<uint32_t>(e.payload)); });
+    bus.subscribe(EventType::TicketIssued, [&](const Event& e) { asyncReceived.push_back(std::get<uint32_t>(e.payload)); },
+                  SubscribeOptions{.name = "observer", .async = true});
+
+    AsyncEventWorker* slow = bus.createAsyncWorker(AsyncWorkerConfig{.name = "slow", .queueSize = 2});
+    bus.subscribe(EventType::TicketIssued, [&](const Event& e) { slowReceived.push_back(std::get<uint32_t>(e.payload)); },
+                  SubscribeOptions{.name = "slowObserver", .worker = slow});
+
+    for (uint32_t i = 1; i <= 3; i++) {
+        bus.publish(Event(EventType::TicketIssued, 0, i));
+    }
+    bus.processAllPending();
+
+    // Inline handler ran, async handlers are only queued on their workers
+    assert((inlineReceived == std::vector<uint32_t>{1, 2, 3}));
+    assert(asyncReceived.empty() && slowReceived.empty());
+
+    std::vector<AsyncWorkerStats> workers = bus.getAsyncWorkerStats();
+    assert(workers.size() == 2);
+    assert(strcmp(workers[0].name, "EventWorker") == 0 && workers[0].queued == 3 && workers[0].dropped == 0);
+    assert(strcmp(workers[1].name, "slow") == 0 && workers[1].queued == 2 && workers[1].dropped == 1);
+
+    assert(bus.processAsyncPending() == 5);
+    assert((asyncReceived == std::vector<uint32_t>{1, 2, 3}));
+    assert((slowReceived == std::vector<uint32_t>{1, 2}));
+
+    workers = bus.getAsyncWorkerStats();
+    assert(workers[0].delivered == 3);
+    assert(workers[1].delivered == 2 && workers[1].queued == 0 && workers[1].highWatermark == 2);
+    assert(bus.getHandlerStats()[1].calls == 3); // Async handlers are profiled too
+
+    bus.resetStats();
+    assert(bus.getAsyncWorkerStats()[1].dropped == 0);
+
+    // Filtered and lane-bound observers only take worker queue slots for events they want
+    AsyncEventWorker* filtered = bus.createAsyncWorker(AsyncWorkerConfig{.name = "filtered", .queueSize = 1});
+    std::vector<uint32_t> filteredReceived;
+    bus.subscribe(EventType::TicketValidated,
+                  [&](const Event& e) { filteredReceived.push_back(std::get<uint32_t>(e.payload)); },
+                  SubscribeOptions{.worker = filtered, .filter = PayloadFilter::equal(7)});
+    bus.subscribe(EventType::TicketValidated,
+                  [&](const Event& e) { filteredReceived.push_back(100 + e.source); },
+                  SubscribeOptions{.worker = filtered, .source = 2});
+    for (uint32_t i = 1; i <= 7; i++) {
+        bus.publish(Event(EventType::TicketValidated, 0, i));
+        bus.processAllPending();
+    }
+    workers = bus.getAsyncWorkerStats();
+    assert(workers[2].queued == 1 && workers[2].dropped == 0);
+    assert(bus.processAsyncPending() == 1);
+    assert((filteredReceived == std::vector<uint32_t>{7}));
+
+    printf("  ✓ Async handlers decoupled, worker overflow counted per worker\n\n");
+}
+
+/**
+ * @brief Test inline dispatch of events published by handlers
+ */
+void test_inline_dispatch() {
+    printf("Test: Inline dispatch of cascading events\n");
+
+    FreeRtosEventBus bus(4, 4);
+    bus.setInlineDispatch(true);
+    std::vector<EventType> received;
+    bus.subscribe(EventType::EntryButtonPressed, [&](const Event& e) {
+        received.push_back(e.type);
+        const Event events[] = {Event(EventType::TicketIssued, 0, static_cast<uint32_t>(1)),
+                                Event(EventType::EntryBarrierOpened)};
+        bus.publishBatch(events);
+    });
+    bus.subscribe(EventType::TicketIssued, [&](const Event& e) {
+        received.push_back(e.type);
+        bus.publish(Event(EventType::CapacityFull)); // Second-level cascade, after EntryBarrierOpened
+    });
+    for (EventType type : {EventType::EntryBarrierOpened, EventType::CapacityFull, EventType::EntryButtonReleased}) {
+        bus.subscribe(type, [&](const Event& e) { received.push_back(e.type); });
+    }
+
+    // Publishes from outside a dispatch are queued as usual
+    bus.publish(Event(EventType::EntryButtonPressed));
+    bus.publish(Event(EventType::EntryButtonReleased));
+    assert(bus.getStats().lanes[static_cast<size_t>(EventPriority::High)].queued == 2);
+    bus.processAllPending();
+
+    // Cascade completes before the next queued event
+    assert((received == std::vector<EventType>{EventType::EntryButtonPressed, EventType::TicketIssued,
+                                               EventType::EntryBarrierOpened, EventType::CapacityFull,
+                                               EventType::EntryButtonReleased}));
+    EventBusStats stats = bus.getStats();
+    assert(stats.types[eventTypeIndex(EventType::TicketIssued)].inlined == 1);
+    assert(stats.types[eventTypeIndex(EventType::TicketIssued)].published == 1);
+    assert(stats.types[eventTypeIndex(EventType::CapacityFull)].inlined == 1);
+    assert(stats.lanes[static_cast<size_t>(EventPriority::Low)].highWatermark == 0);
+    assert(bus.getLatencyStats(EventType::TicketIssued).count == 1);
+
+    // Disabled: cascades go through the low lane after the queued events
+    received.clear();
+    bus.setInlineDispatch(false);
+    bus.publish(Event(EventType::EntryButtonPressed));
+    bus.publish(Event(EventType::EntryButtonReleased));
+    bus.processAllPending();
+    assert((received == std::vector<EventType>{EventType::EntryButtonPressed, EventType::EntryButtonReleased,
+                                               EventType::TicketIssued, EventType::EntryBarrierOpened,
+                                               EventType::CapacityFull}));
+
+    // A dispatch on another task while the FIFO is owned queues its cascade
+    FreeRtosEventBus shared(4, 4);
+    shared.setInlineDispatch(true);
+    shared.subscribe(EventType::EntryButtonPressed, [&shared](const Event&) {
+        (void) shared.publishFromISR(Event(EventType::EntryButtonReleased)); // Queued, never inlined
+        std::thread other([&shared] {
+            Event out;
+            assert(shared.waitForEvent(out, 0) && out.type == EventType::EntryButtonReleased);
+        });
+        other.join();
+    });
+    shared.subscribe(EventType::EntryButtonReleased,
+                     [&shared](const Event&) { shared.publish(Event(EventType::CarExitedParking)); });
+    shared.publish(Event(EventType::EntryButtonPressed));
+    shared.processAllPending();
+    stats = shared.getStats();
+    assert(stats.types[eventTypeIndex(EventType::CarExitedParking)].published == 1);
+    assert(stats.types[eventTypeIndex(EventType::CarExitedParking)].inlined == 0);
+
+    printf("  ✓ Cascading events dispatched in publish order before the next queued event\n\n");
+}
+
+/**
+ * @brief Test category subscriptions receive every event of their categories
+ */
+void test_category_subscriptions() {
+    printf("Test: Category subscriptions\n");
+
+    static_assert(eventCategory(EventType::EntryButtonPressed) == EVENT_CATEGORY_HARDWARE);
+    static_assert(eventCategory(EventType::TicketIssued) == EVENT_CATEGORY_SYSTEM);
+    static_assert(eventCategory(EventType::CarExitedParking) == EVENT_CATEGORY_STATE);
+    static_assert(eventCategory(EventType::BarrierTimeout) == EVENT_CATEGORY_TIMER);
+    for (size_t i = 0; i < EVENT_TYPE_COUNT; i++) {
+        EventCategoryMask category = eventCategory(static_cast<EventType>(i));
+        assert(category != 0 && (category & (category - 1)) == 0 && (category & ~EVENT_CATEGORY_ALL) == 0);
+    }
+
+    FreeRtosEventBus bus(32, 32);
+    std::vector<std::pair<char, EventType>> received;
+    bus.subscribeCategory(EVENT_CATEGORY_STATE | EVENT_CATEGORY_TIMER,
+                          [&](const Event& e) { received.emplace_back('c', e.type); });
+    bus.subscribe(EventType::EntryBarrierOpened, [&](const Event& e) { received.emplace_back('t', e.type); });
+    size_t everything = 0;
+    bus.subscribeCategory(EVENT_CATEGORY_ALL, [&everything](const Event&) { everything++; },
+                          SubscribeOptions{.name = "monitor"});
+
+    for (size_t i = 0; i < EVENT_TYPE_COUNT; i++) {
+        bus.publish(Event(static_cast<EventType>(i)));
+    }
+    bus.processAllPending();
+
+    assert(everything == EVENT_TYPE_COUNT);
+    // Type handler first, then category handlers; only state and timer events reach the first one
+    assert(received.size() == 8);
+    auto opened = std::find(received.begin(), received.end(), std::make_pair('t', EventType::EntryBarrierOpened));
+    assert(opened != received.end() && *(opened + 1) == std::make_pair('c', EventType::EntryBarrierOpened));
+    for (const auto& [who, type] : received) {
+        assert(eventCategory(type) & (EVENT_CATEGORY_STATE | EVENT_CATEGORY_TIMER));
+    }
+
+    std::vector<HandlerStats> handlers = bus.getHandlerStats();
+    assert(handlers[2].categories == EVENT_CATEGORY_ALL && handlers[2].calls == EVENT_TYPE_COUNT);
+
+    // Late category subscription goes through the copy-on-write swap
+    bus.seal();
+    size_t late = 0;
+    bus.subscribeCategory(EVENT_CATEGORY_HARDWARE, [&late](const Event&) { late++; });
+    bus.publish(Event(EventType::EntryButtonPressed));
+    bus.publish(Event(EventType::TicketIssued));
+    bus.processAllPending();
+    assert(late == 1 && everything == EVENT_TYPE_COUNT + 2);
+
+    printf("  ✓ Category handlers matched by precomputed mask, after type handlers\n\n");
+}
+
+/**
+ * @brief Test payload filters are evaluated before handlers are called
+ */
+void test_payload_filters() {
+    printf("Test: Payload-filtered subscriptions\n");
+
+    FreeRtosEventBus bus(32, 32);
+    std::vector<std::pair<char, uint32_t>> received;
+    auto record = [&received](char who) {
+        return [&received, who](const Event& e) { received.emplace_back(who, std::get<uint32_t>(e.payload)); };
+    };
+    bus.subscribe(EventType::TicketValidated, record('7'), SubscribeOptions{.filter = PayloadFilter::equal(7)});
+    bus.subscribe(EventType::TicketValidated, record('3'), SubscribeOptions{.filter = PayloadFilter::equal(3)});
+    bus.subscribe(EventType::TicketValidated, record('r'), SubscribeOptions{.filter = PayloadFilter::range(3, 5)});
+    bus.subscribe(EventType::TicketValidated, record('m'), SubscribeOptions{.filter = PayloadFilter::mask(0x8)});
+    bus.subscribe(EventType::TicketValidated, record('x'), SubscribeOptions{.filter = PayloadFilter::equal(7)});
+    bus.subscribe(EventType::TicketValidated, record('a'));
+    bool flagged = false;
+    bus.subscribe(EventType::EntryBarrierOpened, [&flagged](const Event&) { flagged = true; },
+                  SubscribeOptions{.filter = PayloadFilter::equal(1)});
+
+    for (uint32_t id : {3u, 7u, 9u, 12u}) {
+        bus.publish(Event(EventType::TicketValidated, 0, id));
+    }
+    bus.publish(Event(EventType::EntryBarrierOpened)); // No payload: filtered handler skipped
+    bus.processAllPending();
+    assert(!flagged);
+
+    // Unfiltered first, then equality matches in subscription order, then range/mask
+    using Entry = std::pair<char, uint32_t>;
+    assert((received == std::vector<Entry>{{'a', 3}, {'3', 3}, {'r', 3},
+                                           {'a', 7}, {'7', 7}, {'x', 7},
+                                           {'a', 9}, {'m', 9},
+                                           {'a', 12}, {'m', 12}}));
+
+    // Filtered handlers that do not match are never invoked
+    std::vector<HandlerStats> handlers = bus.getHandlerStats();
+    assert(handlers[0].calls == 1 && handlers[1].calls == 1 && handlers[2].calls == 1);
+    assert(handlers[3].calls == 2 && handlers[4].calls == 1 && handlers[5].calls == 4);
+
+    bus.publish(Event(EventType::EntryBarrierOpened, 0, true));
+    bus.processAllPending();
+    assert(flagged);
+
+    printf("  ✓ Equality, range and mask filters skip non-matching handlers\n\n");
+}
+
+/**
+ * @brief Test lane subscriptions, per-lane coalescing and mixed subscription order
+ */
+void test_source_routing() {
+    printf("Test: Routing and coalescing by event source\n");
+
+    FreeRtosEventBus bus(4, 4);
+    bus.setCoalescing(true);
+    std::vector<std::pair<char, uint8_t>> received;
+    auto record = [&received](char who) {
+        return [&received, who](const Event& e) { received.emplace_back(who, e.source); };
+    };
+    bus.subscribe(EventType::EntryLightBarrierBlocked, record('1'), SubscribeOptions{.source = 1});
+    bus.subscribe(EventType::EntryLightBarrierBlocked, record('a'));
+    bus.subscribe(EventType::EntryLightBarrierBlocked, record('0'), SubscribeOptions{.source = 0});
+    bus.subscribe(EventType::EntryLightBarrierCleared, record('c'), SubscribeOptions{.source = 1});
+    bus.subscribeCategory(EVENT_CATEGORY_HARDWARE, record('h'), SubscribeOptions{.source = 2});
+
+    // Same level source on two lanes is coalesced per lane, not across lanes
+    bus.publish(Event(EventType::EntryLightBarrierBlocked, 0, std::monostate{}, 0));
+    bus.publish(Event(EventType::EntryLightBarrierBlocked, 0, std::monostate{}, 1));
+    bus.publish(Event(EventType::EntryLightBarrierCleared, 0, std::monostate{}, 1));
+    bus.publish(Event(EventType::EntryLightBarrierBlocked, 0, std::monostate{}, 1));
+    bus.publish(Event(EventType::EntryLightBarrierBlocked, 0, std::monostate{}, 2));
+    assert(bus.getStats().lanes[static_cast<size_t>(EventPriority::High)].queued == 3);
+    bus.processAllPending();
+
+    // Lane handlers and handlers for every lane run in subscription order
+    using Entry = std::pair<char, uint8_t>;
+    assert((received == std::vector<Entry>{{'a', 0}, {'0', 0},
+                                           {'1', 1}, {'a', 1},
+                                           {'a', 2}, {'h', 2}}));
+
+    // Trace keeps the lane of each event
+    TraceEntry entries[EventTraceRecorder::CAPACITY];
+    size_t count = bus.getTraceRecorder().snapshot(entries, EventTraceRecorder::CAPACITY);
+    assert(count > 0 && entries[count - 1].source == 2);
+
+    // Sources past MAX_EVENT_SOURCES are refused rather than growing the routing table
+    received.clear();
+    bus.subscribe(EventType::CapacityFull, record('x'), SubscribeOptions{.source = MAX_EVENT_SOURCES});
+    bus.subscribeCategory(EVENT_CATEGORY_HARDWARE, record('y'), SubscribeOptions{.source = 200});
+    bus.publish(Event(EventType::CapacityFull, 0, std::monostate{}, MAX_EVENT_SOURCES));
+    bus.publish(Event(EventType::EntryButtonPressed, 0, std::monostate{}, 200));
+    bus.processAllPending();
+    assert(received.empty());
+
+    printf("  ✓ Lane subscribers see only their lane, flicker merged per lane\n\n");
+}
+
+/**
+ * @brief Test registry-generated tables, payload types and name lookup
+ */
+void test_event_registry() {
+    printf("Test: Event registry tables and name lookup\n");
+
+    static_assert(EVENT_TYPE_COUNT == 18);
+    static_assert(eventPriority(EventType::BarrierTimeout) == EventPriority::High);
+    static_assert(std::is_same_v<EventPayloadType<EventType::TicketIssued>, uint32_t>);
+    static_assert(std::is_same_v<EventPayloadType<EventType::CapacityFull>, std::monostate>);
+    static_assert(LEVEL_SOURCE_COUNT == 2);
+    static_assert(levelSourceIndex(EventType::EntryLightBarrierBlocked) == 0);
+    static_assert(levelSourceIndex(EventType::EntryLightBarrierCleared) == 0);
+    static_assert(levelSourceIndex(EventType::ExitLightBarrierCleared) == 1);
+    static_assert(levelSourceIndex(EventType::EntryButtonPressed) == NO_LEVEL_SOURCE);
+
+    // Every name resolves to its own type through the perfect hash
+    for (size_t i = 0; i < EVENT_TYPE_COUNT; i++) {
+        auto type = static_cast<EventType>(i);
+        EventType found = EventType::BarrierTimeout;
+        assert(eventTypeFromName(eventTypeToString(type), found));
+        assert(found == type);
+    }
+    static_assert([] {
+        EventType type{};
+        return eventTypeFromName("CarExitedParking", type) && type == EventType::CarExitedParking;
+    }());
+
+    EventType unused;
+    assert(!eventTypeFromName("", unused));
+    assert(!eventTypeFromName("TicketIssue", unused));
+    assert(!eventTypeFromName("ticketissued", unused));
+    assert(!eventTypeFromName("list", unused));
+    assert(strcmp(eventTypeToString(static_cast<EventType>(EVENT_TYPE_COUNT)), "Unknown") == 0);
+
+    // Typed accessors and console payload construction follow the declared types
+    Event issued(EventType::TicketIssued, 0, makeEventPayload(EventType::TicketIssued, 42));
+    assert(eventPayload<EventType::TicketIssued>(issued) == 42);
+    assert(std::holds_alternative<std::monostate>(makeEventPayload(EventType::CapacityFull, 42)));
+    assert(eventPayload<EventType::TicketIssued>(Event(EventType::TicketIssued)) == 0);
+    assert(eventHasPayload(EventType::CarEnteredParking) && !eventHasPayload(EventType::EntryButtonPressed));
+
+    printf("  ✓ Names, categories, lanes and payload types from one table\n\n");
+}
+
+int main() {
+    printf("=================================\n");
+    printf("Event Bus Unit Tests\n");
+    printf("=================================\n\n");
+
+    test_dispatch_by_type();
+    test_dispatch_order();
+    test_publish_preserves_event();
+    test_table_covers_all_types();
+    test_late_subscribe_after_seal();
+    test_subscribe_from_handler_after_seal();
+    test_subscribe_from_handler_unsealed();
+    test_event_handler_lifetime();
+    test_publish_batch_all_or_nothing();
+    test_batch_drain_order();
+    test_priority_lanes();
+    test_overflow_drop_newest();
+    test_overflow_drop_oldest();
+    test_overflow_block_with_timeout();
+    test_overflow_overwrite_latest();
+    test_coalescing_level_events();
+    test_isr_event_ring();
+    test_isr_event_ring_coalescing();
+    test_event_loop_start_stop();
+    test_priority_boost();
+    test_event_trace_recorder();
+    test_latency_histogram();
+    test_handler_profiling();
+    test_async_subscribers();
+    test_inline_dispatch();
+    test_category_subscriptions();
+    test_payload_filters();
+    test_source_routing();
+    test_event_registry();
+
+    printf("=================================\n");
+    printf("All tests passed!\n");
+    printf("=================================\n");
+    return 0;
+}
@@ -0,0 +1,89 @@
+/**
+ * @file test_packed_event.cpp
+ * @brief Unit tests for the PackedEvent queue format
+ */
+
+#include "PackedEvent.h"
+#include <cassert>
+#include <cstdio>
+
+static_assert(sizeof(PackedEvent) < sizeof(Event), "Packed format must be smaller than Event");
+
+/**
+ * @brief Test every payload alternative survives a round trip
+ */
+void test_round_trip_payloads() {
+    printf("Test: Round trip of all payload types\n");
+
+    const uint64_t now = 5'000'000;
+
+    Event none(EventType::EntryButtonPressed, now);
+    Event number(EventType::TicketIssued, now, uint32_t{0xDEADBEEF}, 3);
+    Event flagTrue(EventType::CapacityAvailable, now, true);
+    Event flagFalse(EventType::CapacityAvailable, now, false);
+
+    for (const Event& original : {none, number, flagTrue, flagFalse}) {
+        Event copy = unpackEvent(packEvent(original), now);
+        assert(copy.type == original.type);
+        assert(copy.timestamp == original.timestamp);
+        assert(copy.payload == original.payload);
+        assert(copy.source == original.source);
+    }
+
+    printf("  ✓ monostate, uint32_t and bool payloads and source preserved\n\n");
+}
+
+/**
+ * @brief Test every event type fits the 8-bit type field
+ */
+void test_round_trip_all_types() {
+    printf("Test: Round trip of all event types\n");
+
+    for (size_t i = 0; i < EVENT_TYPE_COUNT; i++) {
+        Event original(static_cast<EventType>(i), 1000, uint32_t(i));
+        Event copy = unpackEvent(packEvent(original), 1000);
+        assert(copy.type == original.type);
+        assert(std::get<uint32_t>(copy.payload) == i);
+    }
+
+    printf("  ✓ %u event types preserved\n\n", (unsigned) EVENT_TYPE_COUNT);
+}
+
+/**
+ * @brief Test the 32-bit timestamp is rebuilt across a wrap-around
+ */
+void test_timestamp_reconstruction() {
+    printf("Test: Timestamp reconstruction\n");
+
+    // Published just before the low 32 bits wrap, unpacked just after
+    const uint64_t published = 0x1'FFFF'FF00ULL;
+    const uint64_t received = 0x2'0000'0100ULL;
+    Event copy = unpackEvent(packEvent(Event(EventType::BarrierTimeout, published)), received);
+    assert(copy.timestamp == published);
+
+    // Reference slightly older than the event (e.g. read before a late publish)
+    copy = unpackEvent(packEvent(Event(EventType::BarrierTimeout, received)), published);
+    assert(copy.timestamp == received);
+
+    // Event published ten minutes before dispatch
+    const uint64_t tenMinutes = 10ULL * 60 * 1000 * 1000;
+    copy = unpackEvent(packEvent(Event(EventType::BarrierTimeout, published)), published + tenMinutes);
+    assert(copy.timestamp == published);
+
+    printf("  ✓ Upper timestamp bits restored around wrap-around\n\n");
+}
+
+int main() {
+    printf("=================================\n");
+    printf("Packed Event Unit Tests\n");
+    printf("=================================\n\n");
+
+    test_round_trip_payloads();
+    test_round_trip_all_types();
+    test_timestamp_reconstruction();
+
+    printf("=================================\n");
+    printf("All tests passed!\n");
+    printf("=================================\n");
+    return 0;
+}
@@ -0,0 +1,183 @@
+/**
+ * @file test_payload_pool.cpp
+ * @brief Unit tests for pooled out-of-line event payloads
+ */
+
+#include "FreeRtosEventBus.h"
+#include "PayloadPool.h"
+#include <atomic>
+#include <cassert>
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace {
+
+struct LicensePlate {
+    char text[12];
+    uint8_t lane;
+};
+
+LicensePlate plate(const char* text) {
+    LicensePlate value{};
+    strncpy(value.text, text, sizeof(value.text) - 1);
+    return value;
+}
+
+} // namespace
+
+/**
+ * @brief Test allocation, shared references and reuse of freed blocks
+ */
+void test_allocate_and_release() {
+    printf("Test: Allocate and release pooled payloads\n");
+
+    PayloadPool pool(sizeof(LicensePlate), 2);
+    PayloadRef first = pool.make(plate("B-XY 123"));
+    assert(first && strcmp(first.as<LicensePlate>()->text, "B-XY 123") == 0);
+    assert(first.as<uint32_t>() == nullptr); // Size mismatch
+
+    {
+        PayloadRef copy = first;
+        assert(copy == first && pool.getStats().inUse == 1);
+    }
+    assert(pool.getStats().inUse == 1); // Still referenced by first
+
+    PayloadRef second = pool.make(plate("M-AB 42"));
+    assert(!pool.make(plate("K-CD 7"))); // Exhausted
+    char frame[64] = {};
+    assert(!pool.allocate(frame, sizeof(frame))); // Larger than a block
+
+    // Freed block is reused under a new handle
+    const uint32_t oldHandle = first.handle();
+    first = PayloadRef();
+    PayloadRef third = pool.make(plate("HH-Q 1"));
+    assert(third && third.handle() != oldHandle);
+
+    PayloadPoolStats stats = pool.getStats();
+    assert(stats.inUse == 2 && stats.highWatermark == 2 && stats.failed == 2);
+    assert(strcmp(second.as<LicensePlate>()->text, "M-AB 42") == 0);
+
+    printf("  ✓ Blocks freed with their last reference, exhaustion counted\n\n");
+}
+
+/**
+ * @brief Test the bus and async workers hold their references until dispatch
+ */
+void test_bus_references() {
+    printf("Test: Pooled payloads on the event bus\n");
+
+    PayloadPool pool(sizeof(LicensePlate), 4);
+    FreeRtosEventBus bus(4, 4);
+    std::vector<std::string> seen;
+    std::vector<std::string> asyncSeen;
+    bus.subscribe(EventType::CarEnteredParking, [&](const Event& e) {
+        seen.emplace_back(std::get<PayloadRef>(e.payload).as<LicensePlate>()->text);
+    });
+    bus.subscribe(EventType::CarEnteredParking, [&](const Event& e) {
+        asyncSeen.emplace_back(std::get<PayloadRef>(e.payload).as<LicensePlate>()->text);
+    }, SubscribeOptions{.name = "plateLogger", .async = true});
+
+    bus.publish(Event(EventType::CarEnteredParking, 0, pool.make(plate("B-XY 123"))));
+    assert(pool.getStats().inUse == 1); // Only the queue item refers to it now
+
+    bus.processAllPending();
+    assert((seen == std::vector<std::string>{"B-XY 123"}));
+    assert(pool.getStats().inUse == 1); // Waiting in the async worker
+
+    assert(bus.processAsyncPending() == 1);
+    assert((asyncSeen == std::vector<std::string>{"B-XY 123"}));
+    assert(pool.getStats().inUse == 0);
+
+    printf("  ✓ Block freed after the last (async) subscriber\n\n");
+}
+
+/**
+ * @brief Test dropped, evicted, overwritten and undelivered events free their blocks
+ */
+void test_dropped_events_release() {
+    printf("Test: Dropped pooled payloads are released\n");
+
+    PayloadPool pool(sizeof(LicensePlate), 8);
+    {
+        FreeRtosEventBus bus(1, 1);
+        bus.publish(Event(EventType::CarEnteredParking, 0, pool.make(plate("A"))));
+        bus.publish(Event(EventType::CarEnteredParking, 0, pool.make(plate("B")))); // DropNewest
+        assert(pool.getStats().inUse == 1);
+
+        bus.setOverflowPolicy(EventType::CarEnteredParking, OverflowPolicy::DropOldest);
+        bus.publish(Event(EventType::CarEnteredParking, 0, pool.make(plate("C")))); // Evicts A
+        assert(pool.getStats().inUse == 1);
+
+        bus.setOverflowPolicy(EventType::CarEnteredParking, OverflowPolicy::OverwriteLatest);
+        bus.publish(Event(EventType::CarEnteredParking, 0, pool.make(plate("D")))); // Parked
+        bus.publish(Event(EventType::CarEnteredParking, 0, pool.make(plate("E")))); // Replaces D
+        assert(pool.getStats().inUse == 2);
+
+        const Event batch[] = {Event(EventType::CarExitedParking, 0, pool.make(plate("F"))),
+                               Event(EventType::CarExitedParking, 0, pool.make(plate("G")))};
+        assert(!bus.publishBatch(batch));
+        assert(pool.getStats().inUse == 4); // Only the batch array refers to F and G
+    }
+    // Bus destroyed with C and E still queued
+    assert(pool.getStats().inUse == 0);
+
+    printf("  ✓ Every path that loses an event drops its reference\n\n");
+}
+
+/**
+ * @brief Test concurrent allocate/release never hands out a block twice
+ */
+void test_concurrent_allocation() {
+    printf("Test: Concurrent allocation from several producers\n");
+
+    constexpr size_t THREADS = 4;
+    constexpr uint32_t ROUNDS = 20000;
+    PayloadPool pool(sizeof(uint32_t), 8);
+    std::atomic<bool> corrupted{false};
+
+    std::vector<std::thread> threads;
+    for (uint32_t t = 0; t < THREADS; t++) {
+        threads.emplace_back([&pool, &corrupted, t] {
+            for (uint32_t i = 0; i < ROUNDS; i++) {
+                uint32_t value = (t << 24) | i;
+                PayloadRef ref = pool.make(value);
+                if (!ref) {
+                    continue; // All blocks taken by the other threads
+                }
+                PayloadRef copy = ref;
+                std::this_thread::yield();
+                if (*copy.as<uint32_t>() != value) {
+                    corrupted = true;
+                }
+            }
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+
+    PayloadPoolStats stats = pool.getStats();
+    assert(!corrupted.load());
+    assert(stats.inUse == 0 && stats.highWatermark <= 8);
+
+    printf("  ✓ %u allocations without sharing a live block\n\n", (unsigned) (THREADS * ROUNDS - stats.failed));
+}
+
+int main() {
+    printf("=================================\n");
+    printf("Payload Pool Unit Tests\n");
+    printf("=================================\n\n");
+
+    test_allocate_and_release();
+    test_bus_references();
+    test_dropped_events_release();
+    test_concurrent_allocation();
+
+    printf("=================================\n");
+    printf("All tests passed!\n");
+    printf("=================================\n");
+    return 0;
+}
@@ -0,0 +1,219 @@
+/**
+ * @file test_sharded_event_bus.cpp
+ * @brief Unit tests for ShardedEventBus routing and cross-shard ordering
+ */
+
+#include "FreeRtosEventBus.h"
+#include "ShardedEventBus.h"
+#include "StdThreadEventBus.h"
+#include <array>
+#include <atomic>
+#include <cassert>
+#include <chrono>
+#include <cstdio>
+#include <thread>
+#include <vector>
+
+/**
+ * @brief Test lanes are routed to their shard and lane subscriptions stay there
+ */
+void test_route_by_source() {
+    printf("Test: Routing by event source\n");
+
+    ShardedEventBus<FreeRtosEventBus> bus(2, ShardRouting::BySource, 16, 16);
+    assert(bus.shardCount() == 2);
+
+    std::vector<uint8_t> any;
+    std::vector<uint8_t> lane1;
+    bus.subscribe(EventType::EntryLightBarrierBlocked, [&any](const Event& e) { any.push_back(e.source); });
+    bus.subscribe(EventType::EntryLightBarrierBlocked, [&lane1](const Event& e) { lane1.push_back(e.source); },
+                  SubscribeOptions{.source = 1});
+
+    for (uint8_t source : {0, 1, 2, 3}) {
+        bus.publish(Event(EventType::EntryLightBarrierBlocked, 0, std::monostate{}, source));
+    }
+
+    // Even lanes on shard 0, odd lanes on shard 1
+    assert(bus.shard(0).getStats().types[eventTypeIndex(EventType::EntryLightBarrierBlocked)].published == 2);
+    assert(bus.shard(1).getStats().types[eventTypeIndex(EventType::EntryLightBarrierBlocked)].published == 2);
+
+    bus.processAllPending();
+    assert(any.size() == 4);
+    assert((lane1 == std::vector<uint8_t>{1}));
+
+    // A shard part larger than one split batch is rejected before anything is queued
+    std::vector<Event> batch;
+    for (uint32_t i = 0; i < 20; i++) {
+        batch.emplace_back(EventType::TicketIssued, 0, i, static_cast<uint8_t>(i < 18 ? 0 : 1));
+    }
+    assert(!bus.publishBatch(batch));
+    assert(bus.shard(0).getStats().types[eventTypeIndex(EventType::TicketIssued)].queued == 0);
+    assert(bus.shard(1).getStats().types[eventTypeIndex(EventType::TicketIssued)].queued == 0);
+
+    // Shard 0 has no room for its part: that part is rejected whole, shard 1 still queues
+    for (uint32_t i = 0; i < 12; i++) {
+        bus.publish(Event(EventType::TicketIssued, 0, i, 0));
+    }
+    batch.clear();
+    for (uint32_t i = 0; i < 8; i++) {
+        batch.emplace_back(EventType::TicketIssued, 0, i, static_cast<uint8_t>(i < 6 ? 0 : 1));
+    }
+    assert(!bus.publishBatch(batch));
+    assert(bus.shard(0).getStats().types[eventTypeIndex(EventType::TicketIssued)].queued == 12);
+    assert(bus.shard(1).getStats().types[eventTypeIndex(EventType::TicketIssued)].queued == 2);
+
+    printf("  ✓ Lane handlers only subscribed on their lane's shard, batches all-or-nothing per shard\n\n");
+}
+
+/**
+ * @brief Test category routing and ordering of cross-shard publishes
+ */
+void test_route_by_category() {
+    printf("Test: Routing by category with cross-shard publish\n");
+
+    ShardedEventBus<FreeRtosEventBus> bus(2, ShardRouting::ByCategory, 16, 16);
+    bus.assignCategory(EVENT_CATEGORY_HARDWARE, 0);
+    bus.assignCategory(EVENT_CATEGORY_SYSTEM | EVENT_CATEGORY_STATE | EVENT_CATEGORY_TIMER, 1);
+    assert(bus.shardFor(Event(EventType::EntryButtonPressed)) == 0);
+    assert(bus.shardFor(Event(EventType::TicketIssued)) == 1);
+
+    // Button handler on shard 0 issues tickets on shard 1
+    bus.subscribe(EventType::EntryButtonPressed, [&bus](const Event& e) {
+        bus.publish(Event(EventType::TicketIssued, 0, std::get<uint32_t>(e.payload), e.source));
+    });
+    std::vector<uint32_t> tickets;
+    bus.subscribe(EventType::TicketIssued, [&tickets](const Event& e) { tickets.push_back(std::get<uint32_t>(e.payload)); });
+    uint32_t stateEvents = 0;
+    bus.subscribeCategory(EVENT_CATEGORY_STATE, [&stateEvents](const Event&) { stateEvents++; });
+
+    for (uint32_t id = 1; id <= 5; id++) {
+        bus.publish(Event(EventType::EntryButtonPressed, 0, id));
+    }
+    bus.processAllPending();
+    assert((tickets == std::vector<uint32_t>{1, 2, 3, 4, 5}));
+
+    // Batch spanning both shards is queued per shard, in order
+    const Event batch[] = {Event(EventType::TicketIssued, 0, uint32_t{6}), Event(EventType::EntryBarrierOpened),
+                           Event(EventType::EntryButtonPressed, 0, uint32_t{7})};
+    assert(bus.publishBatch(batch));
+    bus.processAllPending();
+    assert((tickets == std::vector<uint32_t>{1, 2, 3, 4, 5, 6, 7}));
+    assert(stateEvents == 1);
+
+    // Off the shard loops the bus is polled: no pending event returns at once, whatever the timeout
+    Event out;
+    assert(!bus.waitForEvent(out, 1000));
+    bus.publish(Event(EventType::TicketIssued, 0, uint32_t{8}));
+    assert(bus.waitForEvent(out, 0) && eventPayload<EventType::TicketIssued>(out) == 8);
+
+    printf("  ✓ Cascades across shards keep publish order\n\n");
+}
+
+/**
+ * @brief Test shard loop threads keep per-source order under concurrent publishers
+ */
+void test_threaded_shards() {
+    printf("Test: Threaded shards with concurrent publishers\n");
+
+    constexpr uint8_t SOURCES = 4;
+    constexpr uint32_t EVENTS_PER_SOURCE = 5000;
+
+    ShardedEventBus<StdThreadEventBus> bus(2, ShardRouting::BySource, 64, 64);
+    for (size_t i = 0; i < bus.shardCount(); i++) {
+        // Publishers wait for room instead of dropping
+        bus.shard(i).setOverflowPolicy(OverflowPolicy::BlockWithTimeout);
+        bus.shard(i).setBlockTimeout(10000);
+    }
+    std::array<uint32_t, SOURCES> next{};
+    std::atomic<bool> ordered{true};
+    std::atomic<uint32_t> received{0};
+    // Each source lives on one shard, so its slot of next is only touched by one thread
+    bus.subscribe(EventType::TicketIssued, [&](const Event& e) {
+        uint32_t sequence = std::get<uint32_t>(e.payload);
+        if (sequence != next[e.source]) {
+            ordered = false;
+        }
+        next[e.source] = sequence + 1;
+        received.fetch_add(1, std::memory_order_relaxed);
+    });
+    bus.startEventLoops();
+
+    std::vector<std::thread> publishers;
+    for (uint8_t source = 0; source < SOURCES; source++) {
+        publishers.emplace_back([&bus, source] {
+            for (uint32_t i = 0; i < EVENTS_PER_SOURCE; i++) {
+                bus.publish(Event(EventType::TicketIssued, 0, i, source));
+            }
+        });
+    }
+    for (auto& publisher : publishers) {
+        publisher.join();
+    }
+
+    auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(10);
+    while (received.load() < SOURCES * EVENTS_PER_SOURCE && std::chrono::steady_clock::now() < deadline) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    bus.stopEventLoops();
+
+    assert(received.load() == SOURCES * EVENTS_PER_SOURCE);
+    assert(ordered.load());
+    assert(bus.shard(0).dispatchedCount() == bus.shard(1).dispatchedCount());
+
+    printf("  ✓ %u events from %u sources dispatched in order on 2 shard threads\n\n",
+           (unsigned) (SOURCES * EVENTS_PER_SOURCE), (unsigned) SOURCES);
+}
+
+/**
+ * @brief Test a pinned source keeps total order under category routing
+ */
+void test_pinned_source() {
+    printf("Test: Pinned source under category routing\n");
+
+    ShardedEventBus<FreeRtosEventBus> bus(2, ShardRouting::ByCategory, 16, 16);
+    bus.assignCategory(EVENT_CATEGORY_HARDWARE | EVENT_CATEGORY_STATE, 0);
+    bus.assignCategory(EVENT_CATEGORY_SYSTEM | EVENT_CATEGORY_TIMER, 1);
+    bus.pinSource(1, 0);
+    bus.pinSource(1, 5); // Out of range: ignored
+    assert(bus.shardFor(Event(EventType::TicketIssued, 0, uint32_t{0}, 0)) == 1);
+    assert(bus.shardFor(Event(EventType::TicketIssued, 0, uint32_t{0}, 1)) == 0);
+
+    std::vector<uint32_t> seen;
+    std::vector<uint32_t> lane1;
+    auto record = [](std::vector<uint32_t>& out) {
+        return [&out](const Event& e) { out.push_back(std::get<uint32_t>(e.payload)); };
+    };
+    bus.subscribe(EventType::TicketIssued, record(seen));
+    bus.subscribe(EventType::CarEnteredParking, record(seen));
+    bus.subscribe(EventType::TicketIssued, record(lane1), SubscribeOptions{.source = 1});
+
+    // Lane 1 mixes categories but stays in publish order; lane 0 still splits by category
+    bus.publish(Event(EventType::TicketIssued, 0, uint32_t{1}, 1));
+    bus.publish(Event(EventType::CarEnteredParking, 0, uint32_t{9}, 1));
+    bus.publish(Event(EventType::TicketIssued, 0, uint32_t{2}, 1));
+    bus.publish(Event(EventType::TicketIssued, 0, uint32_t{3}, 0));
+    assert(bus.shard(0).getStats().types[eventTypeIndex(EventType::TicketIssued)].queued == 2);
+    assert(bus.shard(1).getStats().types[eventTypeIndex(EventType::TicketIssued)].queued == 1);
+
+    bus.processAllPending();
+    assert((seen == std::vector<uint32_t>{1, 9, 2, 3}));
+    assert((lane1 == std::vector<uint32_t>{1, 2}));
+
+    printf("  ✓ Pinned lane dispatched on its home shard in publish order\n\n");
+}
+
+int main() {
+    printf("=================================\n");
+    printf("Sharded Event Bus Unit Tests\n");
+    printf("=================================\n\n");
+
+    test_route_by_source();
+    test_route_by_category();
+    test_pinned_source();
+    test_threaded_shards();
+
+    printf("=================================\n");
+    printf("All tests passed!\n");
+    printf("=================================\n");
+    return 0;
+}
@@ -0,0 +1,179 @@
+/**
+ * @file test_static_event_bus.cpp
+ * @brief Unit tests for the compile-time StaticEventBus
+ */
+
+#include "mocks/MockGate.h"
+#include "mocks/MockGpioInput.h"
+#include "mocks/MockTicketService.h"
+#include "EntryGateController.h"
+#include "ExitGateController.h"
+#include "StaticEventBus.h"
+#include <cassert>
+#include <cstdio>
+#include <string>
+
+namespace {
+
+struct Recorder {
+    std::string log;
+
+    void handle(EventTag<EventType::TicketIssued>, const Event& event) {
+        log += "T" + std::to_string(eventPayload<EventType::TicketIssued>(event));
+    }
+
+    void handle(EventTag<EventType::EntryLightBarrierBlocked>, const Event&) {
+        log += "B";
+    }
+};
+
+struct Counter {
+    Recorder* recorder = nullptr;
+    uint32_t tickets = 0;
+
+    void handle(EventTag<EventType::TicketIssued>, const Event&) {
+        tickets++;
+        recorder->log += "c";
+    }
+};
+
+using TestBus = StaticEventBus<Recorder, Counter>;
+
+static_assert(TestBus::subscriberCount<EventType::TicketIssued>() == 2);
+static_assert(TestBus::subscriberCount<EventType::EntryLightBarrierBlocked>() == 1);
+static_assert(TestBus::subscriberCount<EventType::CapacityFull>() == 0);
+
+} // namespace
+
+/**
+ * @brief Test handlers are resolved per type and run in subscriber order
+ */
+void test_static_dispatch() {
+    printf("Test: Static dispatch in subscriber order\n");
+
+    TestBus bus(8, 8);
+    Recorder recorder;
+    Counter counter{&recorder};
+    bus.bind(recorder, counter);
+
+    bus.publish(Event(EventType::TicketIssued, 0, uint32_t{1}));
+    bus.publish(Event(EventType::CapacityFull)); // No static subscriber
+    bus.publish(Event(EventType::EntryLightBarrierBlocked));
+    bus.processAllPending();
+
+    // Sensor lane first, then both ticket subscribers in list order
+    assert(recorder.log == "BT1c");
+    assert(counter.tickets == 1);
+
+    printf("  ✓ Only subscribers with a matching handle() overload are called\n\n");
+}
+
+/**
+ * @brief Test the FreeRtosEventBus queue semantics carry over
+ */
+void test_static_queue_semantics() {
+    printf("Test: Queueing semantics of the static bus\n");
+
+    TestBus bus(2, 2);
+    Recorder recorder;
+    Counter counter{&recorder};
+
+    // Events stay queued until subscribers are bound
+    bus.publish(Event(EventType::TicketIssued, 0, uint32_t{1}));
+    bus.processAllPending();
+    assert(recorder.log.empty());
+    bus.startEventLoop(); // Refused: nothing to dispatch to yet
+    assert(!bus.isEventLoopRunning());
+    bus.bind(recorder, counter);
+
+    // Lane overflow is counted like on the runtime bus
+    bus.publish(Event(EventType::TicketIssued, 0, uint32_t{2}));
+    bus.publish(Event(EventType::TicketIssued, 0, uint32_t{3}));
+    assert(bus.queue().getStats().types[eventTypeIndex(EventType::TicketIssued)].dropped == 1);
+
+    // Coalesced flicker dispatches first and last level only
+    bus.queue().setCoalescing(true);
+    for (int i = 0; i < 3; i++) {
+        bus.publish(Event(EventType::EntryLightBarrierBlocked));
+        bus.publish(Event(EventType::EntryLightBarrierCleared));
+    }
+    bus.processAllPending();
+    assert(recorder.log == "BT1cT2c");
+
+    // Dispatches reach the trace and the latency histogram
+    assert(bus.queue().getLatencyStats(EventType::TicketIssued).count == 2);
+
+    Event out;
+    bus.publish(Event(EventType::TicketIssued, 0, uint32_t{4}));
+    assert(bus.waitForEvent(out, 0));
+    assert(out.type == EventType::TicketIssued && counter.tickets == 3);
+    assert(!bus.waitForEvent(out, 0));
+
+    printf("  ✓ Lanes, overflow, coalescing and statistics unchanged\n\n");
+}
+
+/**
+ * @brief Test gate controllers as static subscribers behind the IEventBus adapter
+ */
+void test_static_gate_controllers() {
+    printf("Test: Gate controllers on the static bus\n");
+
+    using GateBus = StaticEventBus<EntryGateController, ExitGateController>;
+    GateBus bus;
+    StaticEventBusAdapter<GateBus> adapter(bus);
+
+    MockGpioInput button;
+    MockGate entryGate;
+    MockGate exitGate;
+    MockTicketService tickets(5);
+    EntryGateController entry(adapter, button, entryGate, tickets, 100, 0, SubscriptionMode::Static);
+    ExitGateController exitc(adapter, exitGate, tickets, 100, 10, 0, SubscriptionMode::Static);
+    bus.bind(entry, exitc);
+
+    // Runtime subscribers through the adapter run after the static ones
+    uint32_t issued = 0;
+    adapter.subscribe(EventType::TicketIssued, [&issued](const Event&) { issued++; });
+
+    adapter.publish(Event(EventType::EntryButtonPressed));
+    adapter.processAllPending();
+    assert(entry.getState() == EntryGateState::OpeningBarrier);
+    assert(entryGate.isOpen());
+    assert(issued == 1);
+
+    // Async handlers cannot run on the static bus, and the runtime table is frozen once the loop runs
+    adapter.subscribe(EventType::TicketIssued, [&issued](const Event&) { issued += 100; },
+                      SubscribeOptions{.async = true});
+    bus.startEventLoop();
+    adapter.subscribe(EventType::TicketIssued, [&issued](const Event&) { issued += 100; });
+    bus.stopEventLoop();
+    adapter.publish(Event(EventType::TicketIssued, 0, uint32_t{9}));
+    adapter.processAllPending();
+    assert(issued == 2);
+
+    // Other lanes are ignored by the lane 0 controllers
+    entry.TEST_forceBarrierTimeout();
+    adapter.publish(Event(EventType::EntryLightBarrierBlocked, 0, std::monostate{}, 1));
+    adapter.processAllPending();
+    assert(entry.getState() == EntryGateState::WaitingForCar);
+    adapter.publish(Event(EventType::EntryLightBarrierBlocked));
+    adapter.processAllPending();
+    assert(entry.getState() == EntryGateState::CarPassing);
+    assert(exitc.getState() == ExitGateState::Idle);
+
+    printf("  ✓ Entry flow driven by compile-time dispatch\n\n");
+}
+
+int main() {
+    printf("=================================\n");
+    printf("Static Event Bus Unit Tests\n");
+    printf("=================================\n\n");
+
+    test_static_dispatch();
+    test_static_queue_semantics();
+    test_static_gate_controllers();
+
+    printf("=================================\n");
+    printf("All tests passed!\n");
+    printf("=================================\n");
+    return 0;
+}
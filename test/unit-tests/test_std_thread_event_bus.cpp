@@ -0,0 +1,233 @@
+/**
+ * @file test_std_thread_event_bus.cpp
+ * @brief Unit tests for the multithreaded host event bus
+ */
+
+#include "mocks/MockGate.h"
+#include "mocks/MockGpioInput.h"
+#include "EntryGateController.h"
+#include "StdThreadEventBus.h"
+#include "TicketService.h"
+#include <atomic>
+#include <cassert>
+#include <chrono>
+#include <cstdio>
+#include <thread>
+#include <vector>
+
+namespace {
+
+template <typename Condition>
+bool waitUntil(Condition condition) {
+    auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(10);
+    while (!condition()) {
+        if (std::chrono::steady_clock::now() > deadline) {
+            return false;
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    return true;
+}
+
+} // namespace
+
+/**
+ * @brief Test lane order, overflow counters and all-or-nothing batches
+ */
+void test_lanes_and_batches() {
+    printf("Test: Priority lanes and batches\n");
+
+    StdThreadEventBus bus(2, 2);
+    std::vector<EventType> received;
+    auto record = [&received](const Event& e) { received.push_back(e.type); };
+    bus.subscribe(EventType::TicketIssued, record);
+    bus.subscribe(EventType::EntryLightBarrierBlocked, record);
+
+    bus.publish(Event(EventType::TicketIssued, 0, uint32_t{1}));
+    bus.publish(Event(EventType::TicketIssued, 0, uint32_t{2}));
+    bus.publish(Event(EventType::TicketIssued, 0, uint32_t{3})); // Low lane full
+    bus.publish(Event(EventType::EntryLightBarrierBlocked));
+
+    // Batch needs two low slots: rejected as a whole
+    const Event batch[] = {Event(EventType::EntryLightBarrierBlocked), Event(EventType::TicketIssued)};
+    assert(!bus.publishBatch(batch));
+
+    EventBusStats stats = bus.getStats();
+    const EventTypeStats& tickets = stats.types[eventTypeIndex(EventType::TicketIssued)];
+    assert(tickets.published == 4 && tickets.dropped == 2 && tickets.queued == 2);
+    assert(stats.lanes[static_cast<size_t>(EventPriority::High)].queued == 1);
+
+    bus.processAllPending();
+    assert((received == std::vector<EventType>{EventType::EntryLightBarrierBlocked, EventType::TicketIssued,
+                                               EventType::TicketIssued}));
+    assert(bus.getLatencyStats(EventType::TicketIssued).count == 2);
+    assert(bus.getStats().types[eventTypeIndex(EventType::TicketIssued)].queued == 0);
+
+    printf("  ✓ High lane first, overflow and rejected batches counted\n\n");
+}
+
+/**
+ * @brief Test DropOldest, OverwriteLatest and BlockWithTimeout
+ */
+void test_overflow_policies() {
+    printf("Test: Overflow policies\n");
+
+    StdThreadEventBus bus(4, 2);
+    std::vector<uint32_t> received;
+    bus.subscribe(EventType::TicketIssued, [&received](const Event& e) { received.push_back(eventPayload<EventType::TicketIssued>(e)); });
+    bus.subscribe(EventType::CarEnteredParking, [&received](const Event& e) { received.push_back(100 + eventPayload<EventType::CarEnteredParking>(e)); });
+
+    bus.setOverflowPolicy(EventType::TicketIssued, OverflowPolicy::DropOldest);
+    for (uint32_t i = 1; i <= 3; i++) {
+        bus.publish(Event(EventType::TicketIssued, 0, i));
+    }
+    bus.processAllPending();
+    assert((received == std::vector<uint32_t>{2, 3}));
+
+    // Parked after the lane's queue, newer parked events replace older ones
+    received.clear();
+    bus.setOverflowPolicy(EventType::CarEnteredParking, OverflowPolicy::OverwriteLatest);
+    bus.publish(Event(EventType::TicketIssued, 0, uint32_t{4}));
+    bus.publish(Event(EventType::TicketIssued, 0, uint32_t{5}));
+    for (uint32_t i = 1; i <= 3; i++) {
+        bus.publish(Event(EventType::CarEnteredParking, 0, i));
+    }
+    assert(bus.getStats().types[eventTypeIndex(EventType::CarEnteredParking)].dropped == 2);
+    bus.processAllPending();
+    assert((received == std::vector<uint32_t>{4, 5, 103}));
+
+    // A blocked publisher continues once the loop thread makes room
+    bus.setOverflowPolicy(OverflowPolicy::BlockWithTimeout);
+    bus.setBlockTimeout(5000);
+    received.clear();
+    bus.publish(Event(EventType::TicketIssued, 0, uint32_t{6}));
+    bus.publish(Event(EventType::TicketIssued, 0, uint32_t{7}));
+    std::thread publisher([&bus] { bus.publish(Event(EventType::TicketIssued, 0, uint32_t{8})); });
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    bus.startEventLoop();
+    publisher.join();
+    assert(waitUntil([&bus] { return bus.dispatchedCount() == 8; }));
+    bus.stopEventLoop();
+    assert((received == std::vector<uint32_t>{6, 7, 8}));
+    assert(bus.getStats().types[eventTypeIndex(EventType::TicketIssued)].dropped == 1);
+
+    printf("  ✓ Same policy semantics as FreeRtosEventBus\n\n");
+}
+
+/**
+ * @brief Test concurrent publishers on the loop thread keep per-publisher order
+ */
+void test_concurrent_publishers() {
+    printf("Test: Concurrent publishers and loop thread\n");
+
+    constexpr uint8_t PUBLISHERS = 4;
+    constexpr uint32_t EVENTS_PER_PUBLISHER = 5000;
+
+    StdThreadEventBus bus(16, 16);
+    bus.setOverflowPolicy(OverflowPolicy::BlockWithTimeout);
+    bus.setBlockTimeout(10000);
+
+    std::array<uint32_t, PUBLISHERS> next{};
+    std::atomic<bool> ordered{true};
+    std::atomic<uint32_t> received{0};
+    std::atomic<uint32_t> categoryEvents{0};
+    std::thread::id loopThread;
+    bus.subscribe(EventType::TicketIssued, [&](const Event& e) {
+        uint32_t sequence = eventPayload<EventType::TicketIssued>(e);
+        if (sequence != next[e.source]) {
+            ordered = false;
+        }
+        next[e.source] = sequence + 1;
+        loopThread = std::this_thread::get_id();
+        received.fetch_add(1, std::memory_order_relaxed);
+    });
+    bus.subscribeCategory(EVENT_CATEGORY_SYSTEM, [&categoryEvents](const Event&) { categoryEvents++; });
+    bus.startEventLoop();
+    assert(bus.isEventLoopRunning());
+
+    std::vector<std::thread> publishers;
+    for (uint8_t source = 0; source < PUBLISHERS; source++) {
+        publishers.emplace_back([&bus, source] {
+            for (uint32_t i = 0; i < EVENTS_PER_PUBLISHER; i++) {
+                bus.publish(Event(EventType::TicketIssued, 0, i, source));
+            }
+        });
+    }
+    for (auto& publisher : publishers) {
+        publisher.join();
+    }
+
+    assert(waitUntil([&received] { return received.load() == PUBLISHERS * EVENTS_PER_PUBLISHER; }));
+    bus.stopEventLoop();
+    assert(!bus.isEventLoopRunning());
+    assert(ordered.load());
+    assert(categoryEvents.load() == PUBLISHERS * EVENTS_PER_PUBLISHER);
+    assert(loopThread != std::this_thread::get_id());
+    assert(bus.getStats().types[eventTypeIndex(EventType::TicketIssued)].dropped == 0);
+
+    // Stop from a handler only requests it; the join happens on the next call from outside
+    bus.subscribe(EventType::CapacityFull, [&bus](const Event&) { bus.stopEventLoop(); });
+    bus.startEventLoop();
+    bus.publish(Event(EventType::CapacityFull));
+    assert(waitUntil([&bus] { return !bus.isEventLoopRunning(); }));
+    bus.stopEventLoop();
+
+    printf("  ✓ %u events from %u threads dispatched in order on the loop thread\n\n",
+           (unsigned) (PUBLISHERS * EVENTS_PER_PUBLISHER), (unsigned) PUBLISHERS);
+}
+
+/**
+ * @brief Test an entry gate controller driven from another thread
+ */
+void test_entry_controller_on_loop_thread() {
+    printf("Test: Entry gate controller on the loop thread\n");
+
+    StdThreadEventBus bus(16, 16);
+    bus.setOverflowPolicy(OverflowPolicy::BlockWithTimeout);
+    MockGpioInput button;
+    MockGate gate;
+    TicketService tickets(10);
+    EntryGateController entry(bus, button, gate, tickets, 100);
+
+    // Timer expiry is delivered as an event so the controller only runs on the loop thread
+    bus.subscribe(EventType::BarrierTimeout, [&entry](const Event&) { entry.TEST_forceBarrierTimeout(); });
+    std::atomic<uint32_t> cars{0};
+    bus.subscribe(EventType::CarEnteredParking, [&cars](const Event&) { cars++; });
+    bus.startEventLoop();
+
+    std::thread sensors([&bus] {
+        const EventType flow[] = {EventType::EntryButtonPressed, EventType::BarrierTimeout,
+                                  EventType::EntryLightBarrierBlocked, EventType::EntryLightBarrierCleared,
+                                  EventType::BarrierTimeout, EventType::BarrierTimeout};
+        for (int car = 0; car < 3; car++) {
+            for (EventType type : flow) {
+                bus.publish(Event(type));
+            }
+        }
+    });
+    sensors.join();
+
+    assert(waitUntil([&cars] { return cars.load() == 3; }));
+    assert(waitUntil([&entry] { return entry.getState() == EntryGateState::Idle; }));
+    bus.stopEventLoop();
+    assert(tickets.getActiveTicketCount() == 3);
+    assert(!gate.isOpen());
+
+    printf("  ✓ Three cars through the entry with real concurrency\n\n");
+}
+
+int main() {
+    printf("=================================\n");
+    printf("StdThread Event Bus Unit Tests\n");
+    printf("=================================\n\n");
+
+    test_lanes_and_batches();
+    test_overflow_policies();
+    test_concurrent_publishers();
+    test_entry_controller_on_loop_thread();
+
+    printf("=================================\n");
+    printf("All tests passed!\n");
+    printf("=================================\n");
+    return 0;
+}
@@ -0,0 +1,76 @@
+/**
+ * @file test_ticket_service.cpp
+ * @brief Unit tests for TicketService occupancy counting
+ */
+
+#include "TicketService.h"
+#include <cassert>
+#include <cstdio>
+
+/**
+ * @brief Test the occupancy counter follows issue, use and reset
+ */
+void test_active_count() {
+    printf("Test: Active ticket counter\n");
+
+    TicketService service(3);
+    uint32_t first = service.getNewTicket();
+    uint32_t second = service.getNewTicket();
+    assert(first != 0 && second != 0 && service.getActiveTicketCount() == 2);
+
+    // Unpaid and repeated use do not change occupancy
+    assert(!service.validateAndUseTicket(first));
+    assert(service.payTicket(first) && service.validateAndUseTicket(first));
+    assert(!service.validateAndUseTicket(first));
+    assert(!service.validateAndUseTicket(999));
+    assert(service.getActiveTicketCount() == 1);
+
+    service.reset();
+    assert(service.getActiveTicketCount() == 0);
+    assert(service.getNewTicket() == 1);
+    assert(service.reconcileActiveTicketCount());
+
+    printf("  ✓ Counter updated on issue, use and reset\n\n");
+}
+
+/**
+ * @brief Test capacity with many used tickets still stored
+ */
+void test_capacity_with_history() {
+    printf("Test: Capacity with historic tickets\n");
+
+    constexpr uint32_t CAPACITY = 5;
+    TicketService service(CAPACITY);
+    for (uint32_t i = 0; i < 500; i++) {
+        uint32_t id = service.getNewTicket();
+        assert(id != 0);
+        assert(service.payTicket(id) && service.validateAndUseTicket(id));
+    }
+    assert(service.getActiveTicketCount() == 0);
+
+    for (uint32_t i = 0; i < CAPACITY; i++) {
+        assert(service.getNewTicket() != 0);
+    }
+    assert(service.getNewTicket() == 0); // Full, used tickets do not count
+    assert(service.getActiveTicketCount() == CAPACITY);
+
+    service.setCapacity(CAPACITY + 1);
+    assert(service.getNewTicket() != 0);
+    assert(service.reconcileActiveTicketCount());
+
+    printf("  ✓ Only unused tickets occupy a space\n\n");
+}
+
+int main() {
+    printf("=================================\n");
+    printf("Ticket Service Unit Tests\n");
+    printf("=================================\n\n");
+
+    test_active_count();
+    test_capacity_with_history();
+
+    printf("=================================\n");
+    printf("All tests passed!\n");
+    printf("=================================\n");
+    return 0;
+}
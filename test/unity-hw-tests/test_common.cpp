@@ -40,8 +40,7 @@ ParkingGarageSystem& get_test_system() {
         s_system->initialize();
 
         // Start event loop
-        auto& eventBus = static_cast<FreeRtosEventBus&>(s_system->getEventBus());
-        eventBus.startEventLoop();
+        s_system->getEventBus().startEventLoop();
 
         // Give event loop time to start
         vTaskDelay(pdMS_TO_TICKS(500));